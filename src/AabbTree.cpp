@@ -0,0 +1,424 @@
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include "AabbTree.h"
+
+// A rebuild is due once refits have made the tree this much more costly.
+static constexpr float rebuildFactor = 2.f;
+
+static size_t entityIndex(entt::entity entity) {
+    return static_cast<size_t>(entt::to_entity(entity));
+}
+
+AabbTree::AabbTree(float margin)
+    : m_margin(margin) {
+}
+
+AabbTree::Box AabbTree::merge(const Box& a, const Box& b) {
+    return { { std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y) },
+        { std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y) } };
+}
+
+float AabbTree::perimeter(const Box& box) {
+    return 2.f * ((box.max.x - box.min.x) + (box.max.y - box.min.y));
+}
+
+bool AabbTree::containsBox(const Box& outer, const Box& inner) {
+    return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y &&
+        outer.max.x >= inner.max.x && outer.max.y >= inner.max.y;
+}
+
+float AabbTree::entryTime(const Box& box, const sf::Vector2f& origin, const sf::Vector2f& inverse, float maxTime) {
+    float tMin = 0.f;
+    float tMax = maxTime;
+    // Slab test, one axis at a time.
+    auto clip = [&](float start, float inv, float min, float max) {
+        if (std::isinf(inv))
+            return start >= min && start <= max;
+        float t0 = (min - start) * inv;
+        float t1 = (max - start) * inv;
+        if (t0 > t1)
+            std::swap(t0, t1);
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+        return tMin <= tMax;
+    };
+    if (!clip(origin.x, inverse.x, box.min.x, box.max.x) || !clip(origin.y, inverse.y, box.min.y, box.max.y))
+        return -1.f;
+    return tMin;
+}
+
+AabbTree::Box AabbTree::fatBox(const sf::FloatRect& bounds) const {
+    const sf::Vector2f margin(m_margin, m_margin);
+    return { bounds.position - margin, bounds.position + bounds.size + margin };
+}
+
+int32_t AabbTree::allocateNode() {
+    if (m_free == nullNode) {
+        m_nodes.emplace_back();
+        return static_cast<int32_t>(m_nodes.size() - 1);
+    }
+    const int32_t node = m_free;
+    m_free = m_nodes[node].parent;
+    m_nodes[node] = Node{};
+    return node;
+}
+
+void AabbTree::freeNode(int32_t node) {
+    m_nodes[node].parent = m_free;
+    m_nodes[node].left = nullNode;
+    m_nodes[node].entity = entt::null;
+    m_free = node;
+}
+
+// Attach leaf next to the sibling that grows the tree's perimeter least.
+void AabbTree::insertLeaf(int32_t leaf) {
+    if (m_root == nullNode) {
+        m_root = leaf;
+        m_nodes[leaf].parent = nullNode;
+        return;
+    }
+
+    const Box box = m_nodes[leaf].box;
+    int32_t sibling = m_root;
+    while (!m_nodes[sibling].isLeaf()) {
+        const Node& node = m_nodes[sibling];
+        const float area = perimeter(node.box);
+        const float combined = perimeter(merge(node.box, box));
+        // Cost of pairing with this node, and the growth every ancestor pays
+        // when the leaf goes further down.
+        const float cost = 2.f * combined;
+        const float inherited = 2.f * (combined - area);
+        auto descendCost = [&](int32_t child) {
+            const Box merged = merge(m_nodes[child].box, box);
+            if (m_nodes[child].isLeaf())
+                return perimeter(merged) + inherited;
+            return perimeter(merged) - perimeter(m_nodes[child].box) + inherited;
+        };
+        const float left = descendCost(node.left);
+        const float right = descendCost(node.right);
+        if (cost < left && cost < right)
+            break;
+        sibling = left < right ? node.left : node.right;
+    }
+
+    const int32_t oldParent = m_nodes[sibling].parent;
+    const int32_t parent = allocateNode();
+    m_nodes[parent].parent = oldParent;
+    m_nodes[parent].box = merge(box, m_nodes[sibling].box);
+    m_nodes[parent].left = sibling;
+    m_nodes[parent].right = leaf;
+    m_nodes[sibling].parent = parent;
+    m_nodes[leaf].parent = parent;
+    if (oldParent == nullNode) {
+        m_root = parent;
+    }
+    else if (m_nodes[oldParent].left == sibling) {
+        m_nodes[oldParent].left = parent;
+    }
+    else {
+        m_nodes[oldParent].right = parent;
+    }
+
+    for (int32_t node = oldParent; node != nullNode; node = m_nodes[node].parent)
+        m_nodes[node].box = merge(m_nodes[m_nodes[node].left].box, m_nodes[m_nodes[node].right].box);
+}
+
+// Replace leaf's parent with leaf's sibling.
+void AabbTree::removeLeaf(int32_t leaf) {
+    if (leaf == m_root) {
+        m_root = nullNode;
+        return;
+    }
+
+    const int32_t parent = m_nodes[leaf].parent;
+    const int32_t grandParent = m_nodes[parent].parent;
+    const int32_t sibling = m_nodes[parent].left == leaf ? m_nodes[parent].right : m_nodes[parent].left;
+    m_nodes[sibling].parent = grandParent;
+    if (grandParent == nullNode) {
+        m_root = sibling;
+    }
+    else if (m_nodes[grandParent].left == parent) {
+        m_nodes[grandParent].left = sibling;
+    }
+    else {
+        m_nodes[grandParent].right = sibling;
+    }
+    freeNode(parent);
+
+    for (int32_t node = grandParent; node != nullNode; node = m_nodes[node].parent)
+        m_nodes[node].box = merge(m_nodes[m_nodes[node].left].box, m_nodes[m_nodes[node].right].box);
+}
+
+void AabbTree::insert(entt::entity entity, const sf::FloatRect& bounds) {
+    const size_t index = entityIndex(entity);
+    if (index >= m_entries.size())
+        m_entries.resize(index + 1);
+
+    Entry& entry = m_entries[index];
+    if (entry.leaf != nullNode) {
+        if (m_nodes[entry.leaf].entity == entity) {
+            update(entity, bounds);
+            return;
+        }
+        // A destroyed entity whose index was recycled without remove().
+        remove(m_nodes[entry.leaf].entity);
+    }
+
+    // Insertion merges boxes up the tree, which needs them to be current.
+    if (m_needsRefit)
+        refit();
+    const int32_t leaf = allocateNode();
+    m_nodes[leaf].box = fatBox(bounds);
+    m_nodes[leaf].entity = entity;
+    m_entries[index] = { leaf, bounds };
+    insertLeaf(leaf);
+    m_size++;
+}
+
+void AabbTree::update(entt::entity entity, const sf::FloatRect& bounds) {
+    if (!contains(entity)) {
+        insert(entity, bounds);
+        return;
+    }
+
+    Entry& entry = m_entries[entityIndex(entity)];
+    entry.bounds = bounds;
+    Node& leaf = m_nodes[entry.leaf];
+    const Box box{ bounds.position, bounds.position + bounds.size };
+    if (containsBox(leaf.box, box))
+        return;
+    leaf.box = fatBox(bounds);
+    m_needsRefit = true;
+}
+
+void AabbTree::remove(entt::entity entity) {
+    if (!contains(entity))
+        return;
+
+    if (m_needsRefit)
+        refit();
+    Entry& entry = m_entries[entityIndex(entity)];
+    removeLeaf(entry.leaf);
+    freeNode(entry.leaf);
+    entry = Entry{};
+    m_size--;
+}
+
+bool AabbTree::contains(entt::entity entity) const {
+    const size_t index = entityIndex(entity);
+    return index < m_entries.size() && m_entries[index].leaf != nullNode &&
+        m_nodes[m_entries[index].leaf].entity == entity;
+}
+
+void AabbTree::refit() {
+    m_needsRefit = false;
+    if (m_root == nullNode)
+        return;
+
+    // Post-order walk: children are refitted before their parent.
+    std::vector<std::pair<int32_t, bool>> stack;
+    stack.emplace_back(m_root, false);
+    while (!stack.empty()) {
+        auto [node, childrenDone] = stack.back();
+        stack.pop_back();
+        Node& current = m_nodes[node];
+        if (current.isLeaf())
+            continue;
+        if (childrenDone) {
+            current.box = merge(m_nodes[current.left].box, m_nodes[current.right].box);
+            continue;
+        }
+        stack.emplace_back(node, true);
+        stack.emplace_back(current.left, false);
+        stack.emplace_back(current.right, false);
+    }
+}
+
+int32_t AabbTree::build(int32_t* leaves, size_t count, int32_t parent) {
+    if (count == 1) {
+        m_nodes[leaves[0]].parent = parent;
+        return leaves[0];
+    }
+
+    // Split at the median centre along the longest axis of the centres.
+    sf::Vector2f min = m_nodes[leaves[0]].box.min + m_nodes[leaves[0]].box.max;
+    sf::Vector2f max = min;
+    for (size_t i = 1; i < count; ++i) {
+        const sf::Vector2f center = m_nodes[leaves[i]].box.min + m_nodes[leaves[i]].box.max;
+        min = { std::min(min.x, center.x), std::min(min.y, center.y) };
+        max = { std::max(max.x, center.x), std::max(max.y, center.y) };
+    }
+    const bool splitX = max.x - min.x >= max.y - min.y;
+    auto centerOf = [&](int32_t leaf) {
+        const Box& box = m_nodes[leaf].box;
+        return splitX ? box.min.x + box.max.x : box.min.y + box.max.y;
+    };
+    const size_t half = count / 2;
+    std::nth_element(leaves, leaves + half, leaves + count, [&](int32_t lhs, int32_t rhs) {
+        const float l = centerOf(lhs);
+        const float r = centerOf(rhs);
+        return l < r || (l == r && lhs < rhs);
+    });
+
+    const int32_t node = allocateNode();
+    const int32_t left = build(leaves, half, node);
+    const int32_t right = build(leaves + half, count - half, node);
+    Node& current = m_nodes[node];
+    current.parent = parent;
+    current.left = left;
+    current.right = right;
+    current.box = merge(m_nodes[left].box, m_nodes[right].box);
+    return node;
+}
+
+void AabbTree::rebuild() {
+    m_needsRefit = false;
+    if (m_root == nullNode) {
+        m_builtCost = 0.f;
+        return;
+    }
+
+    // Keep the leaves (entries point at them) and free every internal node.
+    std::vector<int32_t> leaves;
+    leaves.reserve(m_size);
+    std::vector<int32_t> stack{ m_root };
+    while (!stack.empty()) {
+        const int32_t node = stack.back();
+        stack.pop_back();
+        if (m_nodes[node].isLeaf()) {
+            leaves.push_back(node);
+            continue;
+        }
+        stack.push_back(m_nodes[node].left);
+        stack.push_back(m_nodes[node].right);
+        freeNode(node);
+    }
+    m_root = build(leaves.data(), leaves.size(), nullNode);
+    m_builtCost = cost();
+}
+
+bool AabbTree::needsRefit() const {
+    return m_needsRefit;
+}
+
+bool AabbTree::needsRebuild() const {
+    return m_size > 2 && cost() > m_builtCost * rebuildFactor;
+}
+
+float AabbTree::cost() const {
+    float total = 0.f;
+    if (m_root == nullNode)
+        return total;
+    std::vector<int32_t> stack{ m_root };
+    while (!stack.empty()) {
+        const Node& node = m_nodes[stack.back()];
+        stack.pop_back();
+        if (node.isLeaf())
+            continue;
+        total += perimeter(node.box);
+        stack.push_back(node.left);
+        stack.push_back(node.right);
+    }
+    return total;
+}
+
+void AabbTree::query(const sf::FloatRect& area, std::vector<entt::entity>& out) const {
+    if (m_root == nullNode)
+        return;
+    const Box box{ area.position, area.position + area.size };
+    auto overlaps = [&](const Box& other) {
+        return other.min.x <= box.max.x && other.max.x >= box.min.x &&
+            other.min.y <= box.max.y && other.max.y >= box.min.y;
+    };
+
+    std::vector<int32_t> stack;
+    stack.reserve(64);
+    stack.push_back(m_root);
+    while (!stack.empty()) {
+        const Node& node = m_nodes[stack.back()];
+        stack.pop_back();
+        if (!overlaps(node.box))
+            continue;
+        if (!node.isLeaf()) {
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+            continue;
+        }
+        // Leaves hold fat boxes; test the entity's own bounds.
+        const sf::FloatRect& bounds = m_entries[entityIndex(node.entity)].bounds;
+        if (overlaps({ bounds.position, bounds.position + bounds.size }))
+            out.push_back(node.entity);
+    }
+}
+
+void AabbTree::nearest(const sf::Vector2f& point, size_t k, std::vector<entt::entity>& out) const {
+    if (m_root == nullNode || k == 0)
+        return;
+    auto distanceSq = [&](const Box& box) {
+        const float dx = std::max({ box.min.x - point.x, 0.f, point.x - box.max.x });
+        const float dy = std::max({ box.min.y - point.y, 0.f, point.y - box.max.y });
+        return dx * dx + dy * dy;
+    };
+
+    // Best-first search. At equal distance internal nodes are expanded before
+    // any leaf is taken, and leaves come out in entity index order.
+    struct Candidate {
+        float distanceSq;
+        int32_t node;
+        bool leaf;
+        size_t index;
+    };
+    auto later = [](const Candidate& lhs, const Candidate& rhs) {
+        if (lhs.distanceSq != rhs.distanceSq)
+            return lhs.distanceSq > rhs.distanceSq;
+        if (lhs.leaf != rhs.leaf)
+            return lhs.leaf;
+        return lhs.index > rhs.index;
+    };
+    std::priority_queue<Candidate, std::vector<Candidate>, decltype(later)> queue(later);
+    auto push = [&](int32_t node) {
+        const Node& current = m_nodes[node];
+        if (current.isLeaf()) {
+            const size_t index = entityIndex(current.entity);
+            const sf::FloatRect& bounds = m_entries[index].bounds;
+            queue.push({ distanceSq({ bounds.position, bounds.position + bounds.size }), node, true, index });
+        }
+        else {
+            queue.push({ distanceSq(current.box), node, false, 0 });
+        }
+    };
+
+    size_t found = 0;
+    push(m_root);
+    while (!queue.empty() && found < k) {
+        const Candidate candidate = queue.top();
+        queue.pop();
+        const Node& node = m_nodes[candidate.node];
+        if (candidate.leaf) {
+            out.push_back(node.entity);
+            found++;
+            continue;
+        }
+        push(node.left);
+        push(node.right);
+    }
+}
+
+const sf::FloatRect& AabbTree::bounds(entt::entity entity) const {
+    return m_entries[entityIndex(entity)].bounds;
+}
+
+size_t AabbTree::size() const {
+    return m_size;
+}
+
+void AabbTree::clear() {
+    m_nodes.clear();
+    m_entries.clear();
+    m_root = nullNode;
+    m_free = nullNode;
+    m_size = 0;
+    m_builtCost = 0.f;
+    m_needsRefit = false;
+}
@@ -0,0 +1,145 @@
+#pragma once
+#ifndef AABB_TREE_H
+#define AABB_TREE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <entt/entt.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+// AabbTree is a dynamic bounding volume hierarchy of entity bounds.
+//
+// Leaves store an entity's bounds grown by a margin ("fat" bounds), so an
+// entity that moves a little stays inside its leaf and update() only records
+// the new bounds. When an entity leaves its fat bounds, update() re-centres
+// the leaf and marks the tree for refit(), which recomputes every internal
+// box in one bottom-up pass instead of reinserting the leaf. Refitting keeps
+// the structure, so its quality decays as entities travel; rebuild() builds
+// a balanced tree from scratch (median splits on the longest axis), and
+// needsRebuild() reports when the tree's cost has doubled since then.
+// insert() and remove() keep the tree valid without a refit.
+//
+// Queries are const and may run concurrently from several threads as long as
+// nothing modifies the tree meanwhile. They must not run on a tree that needs
+// a refit.
+class AabbTree {
+public:
+    explicit AabbTree(float margin = 8.f);
+
+    // Add an entity, or move it if it is already present.
+    void insert(entt::entity entity, const sf::FloatRect& bounds);
+    void update(entt::entity entity, const sf::FloatRect& bounds);
+    void remove(entt::entity entity);
+    [[nodiscard]] bool contains(entt::entity entity) const;
+
+    void refit();
+    void rebuild();
+    [[nodiscard]] bool needsRefit() const;
+    [[nodiscard]] bool needsRebuild() const;
+    // Sum of the perimeters of the internal boxes; lower is better.
+    [[nodiscard]] float cost() const;
+
+    // Append every entity whose bounds intersect area to out.
+    void query(const sf::FloatRect& area, std::vector<entt::entity>& out) const;
+
+    // Visit the entities whose bounds the segment a->b crosses, nearest boxes
+    // first. fn(entity, maxTime) returns the time of its own hit (the fraction
+    // of a->b), or maxTime to ignore the entity; boxes entered after the
+    // earliest hit so far are skipped.
+    template <typename Func>
+    void raycast(const sf::Vector2f& a, const sf::Vector2f& b, Func&& fn) const;
+
+    // The k entities whose bounds are nearest to point (0 if it is inside),
+    // nearest first; equal distances are ordered by entity index.
+    void nearest(const sf::Vector2f& point, size_t k, std::vector<entt::entity>& out) const;
+
+    [[nodiscard]] const sf::FloatRect& bounds(entt::entity entity) const;
+    [[nodiscard]] size_t size() const;
+    void clear();
+
+private:
+    static constexpr int32_t nullNode = -1;
+
+    struct Box {
+        sf::Vector2f min;
+        sf::Vector2f max;
+    };
+    struct Node {
+        Box box;
+        int32_t parent = nullNode; // Next free node while on the free list.
+        int32_t left = nullNode;   // nullNode for leaves.
+        int32_t right = nullNode;
+        entt::entity entity = entt::null;
+
+        [[nodiscard]] bool isLeaf() const { return left == nullNode; }
+    };
+    struct Entry {
+        int32_t leaf = nullNode;
+        sf::FloatRect bounds;
+    };
+
+    [[nodiscard]] static Box merge(const Box& a, const Box& b);
+    [[nodiscard]] static float perimeter(const Box& box);
+    [[nodiscard]] static bool containsBox(const Box& outer, const Box& inner);
+    // Time at which the segment origin + t * delta enters box, or a negative
+    // value if it misses within [0, maxTime].
+    [[nodiscard]] static float entryTime(const Box& box, const sf::Vector2f& origin,
+        const sf::Vector2f& inverse, float maxTime);
+    [[nodiscard]] Box fatBox(const sf::FloatRect& bounds) const;
+
+    int32_t allocateNode();
+    void freeNode(int32_t node);
+    void insertLeaf(int32_t leaf);
+    void removeLeaf(int32_t leaf);
+    int32_t build(int32_t* leaves, size_t count, int32_t parent);
+
+    float m_margin;
+    std::vector<Node> m_nodes;
+    std::vector<Entry> m_entries; // Indexed by entity index.
+    int32_t m_root = nullNode;
+    int32_t m_free = nullNode;
+    size_t m_size = 0;
+    float m_builtCost = 0.f;      // cost() right after the last rebuild.
+    bool m_needsRefit = false;
+};
+
+template <typename Func>
+void AabbTree::raycast(const sf::Vector2f& a, const sf::Vector2f& b, Func&& fn) const {
+    if (m_root == nullNode)
+        return;
+    const sf::Vector2f delta = b - a;
+    // An axis the segment does not move along has an infinite inverse.
+    const sf::Vector2f inverse(1.f / delta.x, 1.f / delta.y);
+    float maxTime = 1.f;
+
+    std::vector<int32_t> stack;
+    stack.reserve(64);
+    stack.push_back(m_root);
+    while (!stack.empty()) {
+        const Node& node = m_nodes[stack.back()];
+        stack.pop_back();
+        if (entryTime(node.box, a, inverse, maxTime) < 0.f)
+            continue;
+        if (node.isLeaf()) {
+            maxTime = std::min(maxTime, fn(node.entity, maxTime));
+            continue;
+        }
+        // Push the farther child first so the nearer one is searched first.
+        const float left = entryTime(m_nodes[node.left].box, a, inverse, maxTime);
+        const float right = entryTime(m_nodes[node.right].box, a, inverse, maxTime);
+        if (left >= 0.f && right >= 0.f) {
+            stack.push_back(left <= right ? node.right : node.left);
+            stack.push_back(left <= right ? node.left : node.right);
+        }
+        else if (left >= 0.f) {
+            stack.push_back(node.left);
+        }
+        else if (right >= 0.f) {
+            stack.push_back(node.right);
+        }
+    }
+}
+
+#endif // AABB_TREE_H
@@ -7,33 +7,38 @@ Animation::Animation(const std::string& id, const sf::Texture& t)
 }
 
 Animation::Animation(const std::string& id, const sf::Texture& t, size_t frameCount, size_t speed)
-    : m_id(id),
-    m_sprite(t, sf::IntRect({ 0, 0 }, { static_cast<int>(t.getSize().x), static_cast<int>(t.getSize().y) })),
-    m_frameCount(frameCount),
+    : Animation(id, TextureRegion{ &t, sf::IntRect({ 0, 0 }, { static_cast<int>(t.getSize().x), static_cast<int>(t.getSize().y) }) },
+        frameCount, speed)
+{
+}
+
+Animation::Animation(const std::string& id, const TextureRegion& region, size_t frameCount, size_t speed)
+    : m_frameCount(frameCount),
     m_currentFrame(0),
-    m_speed(speed)
+    m_speed(speed),
+    m_id(id),
+    m_region(region)
 {
-    // Compute frame size based on the full texture divided by frameCount.
-    m_size = Vector2f(static_cast<float>(t.getSize().x) / static_cast<float>(frameCount),
-        static_cast<float>(t.getSize().y));
-    m_sprite.setOrigin(Vector2f(m_size.x / 2.f, m_size.y / 2.f));
+    // Compute frame size based on the strip divided by frameCount.
+    m_size = Vector2f(static_cast<float>(region.rect.size.x) / static_cast<float>(frameCount),
+        static_cast<float>(region.rect.size.y));
 
     // Set initial texture rectangle.
-    int left = static_cast<int>(std::floor(static_cast<float>(m_currentFrame) * m_size.x));
-    int top = 0;
+    m_frameRect = frameRect(m_currentFrame);
+}
+
+sf::IntRect Animation::frameRect(size_t frame) const {
+    int left = m_region.rect.position.x + static_cast<int>(std::floor(static_cast<float>(frame) * m_size.x));
+    int top = m_region.rect.position.y;
     int width = static_cast<int>(m_size.x);
     int height = static_cast<int>(m_size.y);
-    m_sprite.setTextureRect(sf::IntRect({ left, top }, { left + width, top + height }));
+    return sf::IntRect({ left, top }, { width, height });
 }
 
 void Animation::update() {
     m_currentFrame++;
     size_t animationFrame = (m_currentFrame / m_speed) % m_frameCount;
-    int left = static_cast<int>(animationFrame * m_size.x);
-    int top = 0;
-    int width = static_cast<int>(m_size.x);
-    int height = static_cast<int>(m_size.y);
-    m_sprite.setTextureRect(sf::IntRect({ left, top }, { left + width, top + height }));
+    m_frameRect = frameRect(animationFrame);
 }
 
 bool Animation::hasEnded() const {
@@ -48,19 +53,11 @@ const Vector2f& Animation::getSize() const {
     return m_size;
 }
 
-const sf::Sprite& Animation::getSprite() const {
-    return m_sprite;
-}
-
-sf::Sprite& Animation::getSprite() {
-    return m_sprite;
+TextureRegion Animation::getFrame() const {
+    return TextureRegion{ m_region.texture, m_frameRect, m_region.average };
 }
 
 void Animation::reset() {
     m_currentFrame = 0;
-    int left = 0;
-    int top = 0;
-    int width = static_cast<int>(m_size.x);
-    int height = static_cast<int>(m_size.y);
-    m_sprite.setTextureRect(sf::IntRect({ left, top }, { left + width, top + height }));
+    m_frameRect = frameRect(0);
 }
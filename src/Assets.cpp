@@ -1,10 +1,38 @@
+#include <algorithm>
 #include "Assets.h"
 #include "nlohmann/json.hpp"
 #include "Logger.h"  // Added for logging
 
+// stb_rect_pack ships with ImGui; imgui_draw.cpp compiles its own static copy.
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imstb_rectpack.h"
+
+// Transparent gap kept between packed images so filtering never bleeds.
+static constexpr int atlasPadding = 2;
+
+// Alpha-weighted mean colour of an image, sampled on a sparse grid.
+static sf::Color averageColor(const sf::Image& image) {
+    const sf::Vector2u size = image.getSize();
+    const unsigned int step = std::max(1u, std::max(size.x, size.y) / 64);
+    uint64_t r = 0, g = 0, b = 0, weight = 0;
+    for (unsigned int y = 0; y < size.y; y += step) {
+        for (unsigned int x = 0; x < size.x; x += step) {
+            const sf::Color pixel = image.getPixel({ x, y });
+            r += static_cast<uint64_t>(pixel.r) * pixel.a;
+            g += static_cast<uint64_t>(pixel.g) * pixel.a;
+            b += static_cast<uint64_t>(pixel.b) * pixel.a;
+            weight += pixel.a;
+        }
+    }
+    if (weight == 0)
+        return sf::Color::White;
+    return sf::Color(static_cast<uint8_t>(r / weight), static_cast<uint8_t>(g / weight), static_cast<uint8_t>(b / weight));
+}
+
 using json = nlohmann::json;
 
-void Assets::loadFromFile(const std::string& path) {
+void Assets::loadFromFile(const std::string& path, JobSystem& jobs) {
     std::ifstream file(path);
     if (!file.is_open()) {
         LOG("Could not open asset file: " + path);
@@ -20,6 +48,47 @@ void Assets::loadFromFile(const std::string& path) {
         throw std::runtime_error("Invalid asset file format: missing 'assets' array");
     }
 
+    // Decode every image up front on the job system; only the upload in
+    // addTexture has to happen on this thread.
+    std::vector<std::string> imagePaths;
+    std::vector<std::string> imageNames;
+    std::vector<char> atlasAllowed;
+    for (const auto& asset : j["assets"]) {
+        if (asset.value("type", "") == "Texture" && asset.contains("path")) {
+            imagePaths.push_back(asset["path"].get<std::string>());
+            imageNames.push_back(asset.value("name", ""));
+            // Repeated textures tile by wrapping, so they need their own texture.
+            atlasAllowed.push_back(asset.value("atlas", true) && !asset.value("repeated", false));
+        }
+    }
+    std::vector<sf::Image> images(imagePaths.size());
+    std::vector<char> decoded(imagePaths.size(), 0);
+    jobs.parallelFor(0, imagePaths.size(), 1, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i)
+            decoded[i] = images[i].loadFromFile(imagePaths[i]);
+    });
+    size_t nextImage = 0;
+
+    // Pack small textures into shared atlas pages so they batch together.
+    std::vector<char> packed(imagePaths.size(), 0);
+    const json atlas = j.value("atlas", json::object());
+    if (atlas.value("enabled", false)) {
+        const unsigned int pageSize = atlas.value("pageSize", 2048u);
+        const unsigned int maxTextureSize = std::min(atlas.value("maxTextureSize", 512u), pageSize - atlasPadding);
+        std::vector<std::string> names;
+        std::vector<const sf::Image*> sources;
+        for (size_t i = 0; i < imagePaths.size(); ++i) {
+            const sf::Vector2u size = images[i].getSize();
+            if (decoded[i] && atlasAllowed[i] && !imageNames[i].empty() &&
+                size.x <= maxTextureSize && size.y <= maxTextureSize) {
+                names.push_back(imageNames[i]);
+                sources.push_back(&images[i]);
+                packed[i] = 1;
+            }
+        }
+        packAtlas(names, sources, pageSize);
+    }
+
     for (const auto& asset : j["assets"]) {
         if (!asset.contains("type") || !asset["type"].is_string()) {
             LOG("Asset entry missing 'type' field or it is not a string");
@@ -35,7 +104,15 @@ void Assets::loadFromFile(const std::string& path) {
             }
             std::string name = asset["name"].get<std::string>();
             std::string texturePath = asset["path"].get<std::string>();
-            addTexture(name, texturePath);
+            const size_t image = nextImage++;
+            if (!decoded[image]) {
+                LOG("Could not load texture from file: " + texturePath);
+                throw std::runtime_error("Could not load texture from file: " + texturePath);
+            }
+            if (!packed[image]) {
+                addTexture(name, texturePath, images[image]);
+                m_textureMap.at(name).setRepeated(asset.value("repeated", false));
+            }
         }
         else if (type == "Animation") {
             // Expect "name", "texture", "frames", and "speed" fields.
@@ -49,10 +126,10 @@ void Assets::loadFromFile(const std::string& path) {
             int frames = asset["frames"].get<int>();
             int speed = asset["speed"].get<int>();
 
-            // Retrieve the texture; this will throw if the texture is not found.
-            const sf::Texture& tex = getTexture(texName);
+            // Retrieve the texture region; this will throw if the texture is not found.
+            const TextureRegion& region = getTextureRegion(texName);
             // Use brace initialization to construct an Animation object.
-            addAnimation(animName, Animation{ animName, tex, static_cast<size_t>(frames), static_cast<size_t>(speed) });
+            addAnimation(animName, Animation{ animName, region, static_cast<size_t>(frames), static_cast<size_t>(speed) });
         }
         else if (type == "Font") {
             // Expect "name" and "path" fields.
@@ -81,13 +158,86 @@ void Assets::loadFromFile(const std::string& path) {
     }
 }
 
-void Assets::addTexture(const std::string& name, const std::string& path) {
+void Assets::addTexture(const std::string& name, const std::string& path, const sf::Image& image) {
     sf::Texture texture;
-    if (!texture.loadFromFile(path)) {
+    if (!texture.loadFromImage(image)) {
         LOG("Could not load texture from file: " + path);
         throw std::runtime_error("Could not load texture from file: " + path);
     }
-    m_textureMap.emplace(name, std::move(texture));
+    auto& stored = m_textureMap.emplace(name, std::move(texture)).first->second;
+    const sf::Vector2u size = stored.getSize();
+    addRegion(name, TextureRegion{ &stored, sf::IntRect({ 0, 0 }, { static_cast<int>(size.x), static_cast<int>(size.y) }),
+        averageColor(image) });
+}
+
+void Assets::addRegion(const std::string& name, const TextureRegion& region) {
+    auto [it, inserted] = m_regionIds.emplace(name, static_cast<RegionId>(m_regions.size()));
+    if (inserted)
+        m_regions.push_back(region);
+    else
+        m_regions[it->second] = region;
+}
+
+void Assets::packAtlas(const std::vector<std::string>& names, const std::vector<const sf::Image*>& images,
+    unsigned int pageSize) {
+    std::vector<stbrp_rect> pending(names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        const sf::Vector2u size = images[i]->getSize();
+        pending[i].id = static_cast<int>(i);
+        pending[i].w = static_cast<stbrp_coord>(size.x) + atlasPadding;
+        pending[i].h = static_cast<stbrp_coord>(size.y) + atlasPadding;
+    }
+
+    // Fill one page at a time with whatever still fits.
+    const int side = static_cast<int>(pageSize);
+    std::vector<stbrp_node> nodes(pageSize);
+    while (!pending.empty()) {
+        stbrp_context context;
+        stbrp_init_target(&context, side, side, nodes.data(), static_cast<int>(nodes.size()));
+        stbrp_pack_rects(&context, pending.data(), static_cast<int>(pending.size()));
+
+        // Shrink the page to the packed extent, rounded up to a power of two.
+        unsigned int used = 1;
+        for (const auto& rect : pending) {
+            if (rect.was_packed)
+                used = std::max({ used, static_cast<unsigned int>(rect.x + rect.w), static_cast<unsigned int>(rect.y + rect.h) });
+        }
+        unsigned int extent = 1;
+        while (extent < used)
+            extent *= 2;
+        extent = std::min(extent, pageSize);
+
+        sf::Image page({ extent, extent }, sf::Color::Transparent);
+        auto texture = std::make_unique<sf::Texture>();
+        std::vector<stbrp_rect> unpacked;
+        for (const auto& rect : pending) {
+            if (!rect.was_packed) {
+                unpacked.push_back(rect);
+                continue;
+            }
+            const sf::Image& source = *images[static_cast<size_t>(rect.id)];
+            if (!page.copy(source, { static_cast<unsigned int>(rect.x), static_cast<unsigned int>(rect.y) })) {
+                LOG("Could not copy " + names[static_cast<size_t>(rect.id)] + " into the texture atlas");
+                throw std::runtime_error("Could not copy " + names[static_cast<size_t>(rect.id)] + " into the texture atlas");
+            }
+            const sf::Vector2u size = source.getSize();
+            addRegion(names[static_cast<size_t>(rect.id)], TextureRegion{ texture.get(),
+                sf::IntRect({ rect.x, rect.y }, { static_cast<int>(size.x), static_cast<int>(size.y) }), averageColor(source) });
+        }
+        if (unpacked.size() == pending.size()) {
+            LOG("Texture atlas page size is too small");
+            throw std::runtime_error("Texture atlas page size is too small");
+        }
+
+        if (!texture->loadFromImage(page)) {
+            LOG("Could not create texture atlas page");
+            throw std::runtime_error("Could not create texture atlas page");
+        }
+        m_atlasPages.push_back(std::move(texture));
+        LOG("Packed " + std::to_string(pending.size() - unpacked.size()) + " textures into atlas page " +
+            std::to_string(m_atlasPages.size()) + " (" + std::to_string(extent) + "x" + std::to_string(extent) + ")");
+        pending.swap(unpacked);
+    }
 }
 
 void Assets::addAnimation(const std::string& name, const Animation& animation) {
@@ -115,6 +265,10 @@ void Assets::addSound(const std::string& name, const std::string& path) {
 
 const sf::Texture& Assets::getTexture(const std::string& name) const {
     auto it = m_textureMap.find(name);
+    if (it == m_textureMap.end() && m_regionIds.count(name)) {
+        LOG("Error: Texture \"" + name + "\" is packed into an atlas; use getTextureRegion.");
+        throw std::runtime_error("Texture \"" + name + "\" is packed into an atlas; use getTextureRegion");
+    }
     if (it == m_textureMap.end()) {
         LOG("Error: Texture \"" + name + "\" not found.");
         throw std::runtime_error("Texture \"" + name + "\" not found");
@@ -122,6 +276,31 @@ const sf::Texture& Assets::getTexture(const std::string& name) const {
     return it->second;
 }
 
+const TextureRegion& Assets::getTextureRegion(const std::string& name) const {
+    return m_regions[getRegionId(name)];
+}
+
+RegionId Assets::getRegionId(const std::string& name) const {
+    auto it = m_regionIds.find(name);
+    if (it == m_regionIds.end()) {
+        LOG("Error: Texture \"" + name + "\" not found.");
+        throw std::runtime_error("Texture \"" + name + "\" not found");
+    }
+    return it->second;
+}
+
+const TextureRegion& Assets::getRegion(RegionId id) const {
+    if (id >= m_regions.size()) {
+        LOG("Error: Texture region " + std::to_string(id) + " not found.");
+        throw std::runtime_error("Texture region " + std::to_string(id) + " not found");
+    }
+    return m_regions[id];
+}
+
+const std::vector<TextureRegion>& Assets::getRegions() const {
+    return m_regions;
+}
+
 const Animation& Assets::getAnimation(const std::string& name) const {
     auto it = m_animationMap.find(name);
     if (it == m_animationMap.end()) {
@@ -160,3 +339,7 @@ const std::unordered_map<std::string, Animation>& Assets::getAnimations() const
 std::unordered_map<std::string, sf::Sound>& Assets::getSounds() {
     return m_sounds;
 }
+
+size_t Assets::atlasPageCount() const {
+    return m_atlasPages.size();
+}
@@ -2,25 +2,43 @@
 #ifndef ASSETS_H
 #define ASSETS_H
 
+#include <memory>
 #include <unordered_map>
 #include <string>
+#include <vector>
 #include <stdexcept>
 #include <SFML/Audio/SoundBuffer.hpp>
 #include <SFML/Audio/Sound.hpp>
 #include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include "Animation.h"
+#include "JobSystem.h"
+#include "TextureRegion.h"
 
 // The Assets class now loads its configuration from a JSON file.
+//
+// When the file has an "atlas" object with "enabled": true, textures no larger
+// than its "maxTextureSize" (and not marked "atlas": false) are packed into
+// shared "pageSize" pages. Those are only reachable through getTextureRegion;
+// every other texture is also available as a region covering all of it.
+// Textures marked "repeated": true wrap when sampled and are never atlased.
 class Assets {
 public:
     Assets() = default;
     ~Assets() = default;
 
-    // Loads assets from a JSON file.
-    void loadFromFile(const std::string& path);
+    // Loads assets from a JSON file. Images are decoded in parallel on jobs;
+    // textures are created on the calling (main) thread.
+    void loadFromFile(const std::string& path, JobSystem& jobs);
 
     [[nodiscard]] const sf::Texture& getTexture(const std::string& name) const;
+    [[nodiscard]] const TextureRegion& getTextureRegion(const std::string& name) const;
+    // Regions are also numbered, so components can refer to them with a
+    // RegionId instead of a pointer and rect (see Renderable).
+    [[nodiscard]] RegionId getRegionId(const std::string& name) const;
+    [[nodiscard]] const TextureRegion& getRegion(RegionId id) const;
+    [[nodiscard]] const std::vector<TextureRegion>& getRegions() const;
     [[nodiscard]] const Animation& getAnimation(const std::string& name) const;
     [[nodiscard]] const sf::Font& getFont(const std::string& name) const;
     [[nodiscard]] sf::Sound& getSound(const std::string& name);
@@ -29,15 +47,24 @@ public:
     [[nodiscard]] const std::unordered_map<std::string, sf::Texture>& getTextures() const;
     [[nodiscard]] const std::unordered_map<std::string, Animation>& getAnimations() const;
     [[nodiscard]] std::unordered_map<std::string, sf::Sound>& getSounds();
+    [[nodiscard]] size_t atlasPageCount() const;
 
 private:
     // Helper functions to add assets.
-    void addTexture(const std::string& name, const std::string& path);
+    void addTexture(const std::string& name, const std::string& path, const sf::Image& image);
+    // Pack the given images into atlas pages and register a region for each name.
+    void packAtlas(const std::vector<std::string>& names, const std::vector<const sf::Image*>& images,
+        unsigned int pageSize);
+    // Register (or replace) the region of a texture name.
+    void addRegion(const std::string& name, const TextureRegion& region);
     void addAnimation(const std::string& name, const Animation& animation);
     void addFont(const std::string& name, const std::string& path);
     void addSound(const std::string& name, const std::string& path);
 
     std::unordered_map<std::string, sf::Texture> m_textureMap;
+    std::vector<TextureRegion> m_regions;
+    std::unordered_map<std::string, RegionId> m_regionIds;
+    std::vector<std::unique_ptr<sf::Texture>> m_atlasPages;
     std::unordered_map<std::string, Animation> m_animationMap;
     std::unordered_map<std::string, sf::Font> m_fontMap;
     std::unordered_map<std::string, sf::SoundBuffer> m_soundBuffers;
@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include "Broadphase.h"
+
+// Entities per parallelFor chunk when finding pairs.
+static constexpr size_t pairGrain = 256;
+
+static size_t entityIndex(entt::entity entity) {
+    return static_cast<size_t>(entt::to_entity(entity));
+}
+
+// Union of the collider bounds of entity, leaving out the Skip collider (one
+// that is being removed). Empty if the entity has no other collider.
+template <typename Skip = void>
+static std::optional<sf::FloatRect> boundsWithout(const entt::registry& registry, entt::entity entity) {
+    const auto* transform = registry.try_get<Transform2D>(entity);
+    if (!transform)
+        return std::nullopt;
+
+    std::optional<sf::FloatRect> bounds;
+    auto merge = [&](const Vector2f& min, const Vector2f& max) {
+        if (bounds) {
+            const Vector2f lo(std::min(bounds->position.x, min.x), std::min(bounds->position.y, min.y));
+            const Vector2f hi(std::max(bounds->position.x + bounds->size.x, max.x),
+                std::max(bounds->position.y + bounds->size.y, max.y));
+            bounds = sf::FloatRect(lo, hi - lo);
+        }
+        else {
+            bounds = sf::FloatRect(min, max - min);
+        }
+    };
+    if constexpr (!std::is_same_v<Skip, BoxCollider>) {
+        if (const auto* box = registry.try_get<BoxCollider>(entity)) {
+            const Vector2f center = transform->position + box->offset;
+            merge(center - box->size / 2.f, center + box->size / 2.f);
+        }
+    }
+    if constexpr (!std::is_same_v<Skip, CircleCollider>) {
+        if (const auto* circle = registry.try_get<CircleCollider>(entity)) {
+            const Vector2f center = transform->position + circle->offset;
+            const Vector2f extent(circle->radius, circle->radius);
+            merge(center - extent, center + extent);
+        }
+    }
+    if constexpr (!std::is_same_v<Skip, ComplexCollider>) {
+        if (const auto* complex = registry.try_get<ComplexCollider>(entity)) {
+            // A circle around every rotation of the scaled points.
+            const auto* orientation = registry.try_get<Orientation>(entity);
+            const Vector2f scale = orientation ? orientation->scale : Vector2f(1.f, 1.f);
+            float radiusSq = 0.f;
+            for (const Vector2f& point : complex->points) {
+                const Vector2f scaled(point.x * scale.x, point.y * scale.y);
+                radiusSq = std::max(radiusSq, scaled.x * scaled.x + scaled.y * scaled.y);
+            }
+            const float radius = std::sqrt(radiusSq);
+            merge(transform->position - Vector2f(radius, radius), transform->position + Vector2f(radius, radius));
+        }
+    }
+    return bounds;
+}
+
+Broadphase::Broadphase(float cellSize)
+    : m_grid(cellSize) {
+}
+
+void Broadphase::connect(entt::registry& registry) {
+    registry.on_construct<BoxCollider>().connect<&Broadphase::onColliderConstruct<BoxCollider>>(*this);
+    registry.on_construct<CircleCollider>().connect<&Broadphase::onColliderConstruct<CircleCollider>>(*this);
+    registry.on_destroy<BoxCollider>().connect<&Broadphase::onColliderDestroy<BoxCollider>>(*this);
+    registry.on_destroy<CircleCollider>().connect<&Broadphase::onColliderDestroy<CircleCollider>>(*this);
+    registry.on_construct<ComplexCollider>().connect<&Broadphase::onColliderConstruct<ComplexCollider>>(*this);
+    registry.on_destroy<ComplexCollider>().connect<&Broadphase::onColliderDestroy<ComplexCollider>>(*this);
+    registry.on_update<Transform2D>().connect<&Broadphase::onPlacementUpdate>(*this);
+    registry.on_update<Orientation>().connect<&Broadphase::onPlacementUpdate>(*this);
+
+    for (auto entity : registry.view<Transform2D, BoxCollider>())
+        m_grid.insert(entity, colliderBounds(registry, entity));
+    for (auto entity : registry.view<Transform2D, CircleCollider>())
+        m_grid.insert(entity, colliderBounds(registry, entity));
+    for (auto entity : registry.view<Transform2D, ComplexCollider>())
+        m_grid.insert(entity, colliderBounds(registry, entity));
+}
+
+void Broadphase::disconnect(entt::registry& registry) {
+    registry.on_construct<BoxCollider>().disconnect(this);
+    registry.on_construct<CircleCollider>().disconnect(this);
+    registry.on_destroy<BoxCollider>().disconnect(this);
+    registry.on_destroy<CircleCollider>().disconnect(this);
+    registry.on_construct<ComplexCollider>().disconnect(this);
+    registry.on_destroy<ComplexCollider>().disconnect(this);
+    registry.on_update<Transform2D>().disconnect(this);
+    registry.on_update<Orientation>().disconnect(this);
+    clear();
+}
+
+template <typename Collider>
+void Broadphase::onColliderConstruct(entt::registry& registry, entt::entity entity) {
+    if (auto bounds = boundsWithout(registry, entity))
+        m_grid.insert(entity, *bounds);
+}
+
+// Runs before the component is removed, so its bounds are left out explicitly.
+template <typename Collider>
+void Broadphase::onColliderDestroy(entt::registry& registry, entt::entity entity) {
+    if (auto bounds = boundsWithout<Collider>(registry, entity))
+        m_grid.update(entity, *bounds);
+    else
+        m_grid.remove(entity);
+}
+
+// Colliders without Movement are only refreshed here, when their Transform2D
+// or Orientation is patched or replaced.
+void Broadphase::onPlacementUpdate(entt::registry& registry, entt::entity entity) {
+    if (m_grid.contains(entity) && !registry.all_of<Movement>(entity))
+        m_grid.update(entity, colliderBounds(registry, entity));
+}
+
+void Broadphase::update(const entt::registry& registry) {
+    for (auto entity : registry.view<Transform2D, BoxCollider, Movement>())
+        m_grid.update(entity, colliderBounds(registry, entity));
+    // Entities with several colliders were already refreshed above.
+    for (auto entity : registry.view<Transform2D, CircleCollider, Movement>(entt::exclude<BoxCollider>))
+        m_grid.update(entity, colliderBounds(registry, entity));
+    for (auto entity : registry.view<Transform2D, ComplexCollider, Movement>(entt::exclude<BoxCollider, CircleCollider>))
+        m_grid.update(entity, colliderBounds(registry, entity));
+}
+
+const std::vector<Broadphase::Pair>& Broadphase::findPairs(JobSystem& jobs) {
+    m_entities.clear();
+    m_grid.entities(m_entities);
+
+    // Chunks collect pairs locally and append them once at the end.
+    m_pairs.clear();
+    std::mutex pairsMutex;
+    jobs.parallelFor(0, m_entities.size(), pairGrain, [&](size_t first, size_t last) {
+        std::vector<Pair> found;
+        std::vector<entt::entity> candidates;
+        for (size_t i = first; i < last; ++i) {
+            const entt::entity entity = m_entities[i];
+            candidates.clear();
+            m_grid.query(m_grid.bounds(entity), candidates);
+            for (entt::entity other : candidates) {
+                if (entityIndex(other) > entityIndex(entity))
+                    found.push_back({ entity, other });
+            }
+        }
+        std::lock_guard lock(pairsMutex);
+        m_pairs.insert(m_pairs.end(), found.begin(), found.end());
+    });
+
+    std::sort(m_pairs.begin(), m_pairs.end(), [](const Pair& lhs, const Pair& rhs) {
+        return entityIndex(lhs.a) != entityIndex(rhs.a) ? entityIndex(lhs.a) < entityIndex(rhs.a)
+            : entityIndex(lhs.b) < entityIndex(rhs.b);
+    });
+    return m_pairs;
+}
+
+const std::vector<Broadphase::Pair>& Broadphase::pairs() const {
+    return m_pairs;
+}
+
+sf::FloatRect Broadphase::colliderBounds(const entt::registry& registry, entt::entity entity) {
+    return boundsWithout(registry, entity).value_or(sf::FloatRect());
+}
+
+const SpatialGrid& Broadphase::grid() const {
+    return m_grid;
+}
+
+size_t Broadphase::size() const {
+    return m_grid.size();
+}
+
+void Broadphase::clear() {
+    m_grid.clear();
+    m_entities.clear();
+    m_pairs.clear();
+}
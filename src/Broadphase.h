@@ -0,0 +1,65 @@
+#pragma once
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include <vector>
+#include <entt/entt.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include "Components.hpp"
+#include "JobSystem.h"
+#include "SpatialGrid.h"
+
+// Broadphase finds the pairs of colliders whose world bounds overlap, as
+// candidates for the exact (narrowphase) tests in Physics.
+//
+// Entities with a Transform2D and a Box, Circle or ComplexCollider are kept in
+// a loose SpatialGrid. connect() adds and removes them as colliders come and
+// go, and re-indexes those without Movement when their Transform2D or
+// Orientation is patched or replaced; update() refreshes entities that can
+// move (those with Movement). The grid only relinks an entity when its centre
+// changes cell. findPairs() queries the grid with each entity's bounds in
+// parallel and keeps a pair only from the side with the lower entity index,
+// so every pair is reported once.
+class Broadphase {
+public:
+    // a has the lower entity index.
+    struct Pair {
+        entt::entity a = entt::null;
+        entt::entity b = entt::null;
+    };
+
+    explicit Broadphase(float cellSize = 128.f);
+
+    // Track the colliders of registry from now on (existing ones are added).
+    void connect(entt::registry& registry);
+    void disconnect(entt::registry& registry);
+
+    // Refresh the bounds of moving colliders after a movement step.
+    void update(const entt::registry& registry);
+
+    // Candidate pairs for this tick, ordered by (a, b) index so results do not
+    // depend on thread timing.
+    const std::vector<Pair>& findPairs(JobSystem& jobs);
+    [[nodiscard]] const std::vector<Pair>& pairs() const;
+
+    // World bounds of every collider on entity; a ComplexCollider is bounded
+    // by the circle its points sweep through at any rotation.
+    [[nodiscard]] static sf::FloatRect colliderBounds(const entt::registry& registry, entt::entity entity);
+
+    [[nodiscard]] const SpatialGrid& grid() const;
+    [[nodiscard]] size_t size() const;
+    void clear();
+
+private:
+    template <typename Collider>
+    void onColliderConstruct(entt::registry& registry, entt::entity entity);
+    template <typename Collider>
+    void onColliderDestroy(entt::registry& registry, entt::entity entity);
+    void onPlacementUpdate(entt::registry& registry, entt::entity entity);
+
+    SpatialGrid m_grid;
+    std::vector<entt::entity> m_entities;
+    std::vector<Pair> m_pairs;
+};
+
+#endif // BROADPHASE_H
@@ -3,28 +3,52 @@
 
 #include <SFML/Graphics.hpp>
 #include <vector>
+#include "TextureRegion.h"
 
 using sf::Vector2f;
 
-// Transform2D: holds an entity's position, rotation, and scale.
+// Motion data is split by access frequency. Transform2D and Velocity are hot
+// (read or written every tick); Orientation is cold (only read when drawing).
+// Entities with Transform2D, Velocity and Movement form an owning group, so
+// their hot components are packed in the same order (see Motion).
+
+// Transform2D: holds an entity's position at the current and previous tick.
 struct Transform2D {
 	Vector2f position{ 0.f, 0.f }; // World position
 	Vector2f prevPosition{ 0.f, 0.f }; // Previous World Position
+};
+
+// Orientation: rotation and scale of an entity's drawn quad.
+struct Orientation {
 	float rotation = 0.f;             // Rotation in degrees
 	Vector2f scale{ 1.f, 1.f };     // Scale factors (default is no scaling)
 };
 
-// Movement: stores velocity and acceleration, plus an optional maximum speed.
+// Velocity: current velocity in units per second.
+struct Velocity {
+	Vector2f value{ 0.f, 0.f };
+};
+
+// Movement: acceleration plus an optional maximum speed. Entities without it
+// never move and are drawn from cached static geometry.
 struct Movement {
-	Vector2f velocity{ 0.f, 0.f };      // Current velocity (units per frame or per second)
-	Vector2f acceleration{ 0.f, 0.f };  // Current acceleration
+	Vector2f acceleration{ 0.f, 0.f };  // Units per second squared
 	float maxSpeed = 0.f;                  // Maximum allowed speed (0 if unused)
 };
 
-// Renderable: contains a sprite (or other drawable) plus a layer (z-index) for drawing order.
+// Renderable: what to draw for an entity and on which layer (z-index). It is
+// plain data (12 bytes); the quad is built from the region, centred on the
+// entity's Transform2D, when the entity is drawn.
 struct Renderable {
-	sf::Sprite sprite;  // Sprite used for drawing the entity.
-	int layer = 0;      // Draw order; lower values render first.
+	RegionId region = 0;               // Index into the Assets region table.
+	sf::Color tint = sf::Color::White; // Multiplied with the texture colour.
+	int layer = 0;                     // Draw order; lower values render first.
+};
+
+// Impostor: colour used when a Renderable is too small on screen to draw as a
+// sprite and is shown as a point or as part of a cluster instead.
+struct Impostor {
+	sf::Color color = sf::Color::White;
 };
 
 // BoxCollider: defines an axis-aligned rectangular collider.
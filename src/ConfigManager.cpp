@@ -29,8 +29,26 @@ EngineConfig ConfigManager::load(const std::string& configPath) {
             config.frameRateLimit = j["frameRateLimit"].get<unsigned int>();
         if (j.contains("fullscreen"))
             config.fullscreen = j["fullscreen"].get<bool>();
+        if (j.contains("simulationRate"))
+            config.simulationRate = j["simulationRate"].get<unsigned int>();
+        if (j.contains("simulationSpeed"))
+            config.simulationSpeed = j["simulationSpeed"].get<unsigned int>();
+        if (j.contains("maxTicksPerFrame"))
+            config.maxTicksPerFrame = j["maxTicksPerFrame"].get<unsigned int>();
         if (j.contains("assetConfigPath"))
             config.assetConfigPath = j["assetConfigPath"].get<std::string>();
+        if (j.contains("headless"))
+            config.headless = j["headless"].get<bool>();
+        if (j.contains("headlessTicks"))
+            config.headlessTicks = j["headlessTicks"].get<size_t>();
+        if (j.contains("workerThreads"))
+            config.workerThreads = j["workerThreads"].get<size_t>();
+        if (j.contains("profiler"))
+            config.profiler = j["profiler"].get<bool>();
+        if (j.contains("renderThread"))
+            config.renderThread = j["renderThread"].get<bool>();
+        if (j.contains("idleRendering"))
+            config.idleRendering = j["idleRendering"].get<bool>();
 
     }
     catch (const json::exception& e) {
@@ -40,3 +58,22 @@ EngineConfig ConfigManager::load(const std::string& configPath) {
 
     return config;
 }
+
+void ConfigManager::applyArguments(EngineConfig& config, const std::vector<std::string>& args) {
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--headless") {
+            config.headless = true;
+        }
+        else if (args[i] == "--ticks" && i + 1 < args.size()) {
+            try {
+                config.headlessTicks = std::stoull(args[++i]);
+            }
+            catch (const std::exception&) {
+                throw std::runtime_error("Invalid value for --ticks: " + args[i]);
+            }
+        }
+        else {
+            std::cerr << "Ignoring unknown argument: " << args[i] << std::endl;
+        }
+    }
+}
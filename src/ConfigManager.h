@@ -3,6 +3,7 @@
 #define CONFIG_MANAGER_H
 
 #include <string>
+#include <vector>
 
 // EngineConfig holds settings for the game engine.
 struct EngineConfig {
@@ -11,8 +12,26 @@ struct EngineConfig {
     std::string  windowTitle = "Astral Reign";
     unsigned int frameRateLimit = 60;
     bool         fullscreen = false;
+    // Fixed simulation tick rate (ticks per second of game time at 1x speed).
+    unsigned int simulationRate = 60;
+    // Game time multiplier; each rendered frame runs this many times more ticks.
+    unsigned int simulationSpeed = 1;
+    // Upper bound on ticks run per rendered frame at 1x speed (catch-up limit).
+    unsigned int maxTicksPerFrame = 8;
     // Path to the asset configuration file (to be loaded by Assets)
     std::string  assetConfigPath;
+    // Headless mode: no window, ImGui, or audio; the galaxy is simulated
+    // for headlessTicks ticks as fast as possible and the engine exits.
+    bool         headless = false;
+    size_t       headlessTicks = 3600;
+    // Job system worker threads (0 = one per hardware thread, minus the main thread).
+    size_t       workerThreads = 0;
+    // Start with the frame profiler enabled (F3 toggles it at runtime).
+    bool         profiler = false;
+    // Draw on a dedicated render thread so simulation overlaps with display().
+    bool         renderThread = true;
+    // Skip redrawing while nothing changes and sleep until the next event.
+    bool         idleRendering = true;
 };
 
 class ConfigManager {
@@ -23,6 +42,10 @@ public:
     // Loads engine configuration from the given file path.
     // The implementation should support formats like XML, JSON, YAML, etc.
     EngineConfig load(const std::string& configPath);
+
+    // Overrides loaded settings with command-line arguments
+    // (--headless, --ticks <n>).
+    void applyArguments(EngineConfig& config, const std::vector<std::string>& args);
 };
 
 #endif // CONFIG_MANAGER_H
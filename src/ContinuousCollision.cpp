@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <cmath>
+#include "ContinuousCollision.h"
+
+// Projectiles per parallelFor chunk.
+static constexpr size_t sweepGrain = 64;
+
+static size_t entityIndex(entt::entity entity) {
+    return static_cast<size_t>(entt::to_entity(entity));
+}
+
+static bool isProjectile(const entt::registry& registry, entt::entity entity) {
+    return registry.any_of<TBullet, TProjectile>(entity);
+}
+
+// Keep the earlier of two hits.
+static void keepEarliest(Intersect& earliest, const Intersect& hit) {
+    if (hit.intersect && (!earliest.intersect || hit.time < earliest.time))
+        earliest = hit;
+}
+
+Intersect ContinuousCollision::sweepTarget(const entt::registry& registry, entt::entity target,
+    const Vector2f& a, const Vector2f& b, float radius) {
+    const auto* transform = registry.try_get<Transform2D>(target);
+    if (!transform)
+        return {};
+
+    Intersect earliest;
+    if (const auto* box = registry.try_get<BoxCollider>(target))
+        keepEarliest(earliest, Physics::SweepBox(a, b, transform->position + box->offset,
+            box->size / 2.f + Vector2f(radius, radius)));
+    if (const auto* circle = registry.try_get<CircleCollider>(target))
+        keepEarliest(earliest, Physics::SweepCircle(a, b, transform->position + circle->offset, circle->radius + radius));
+    if (const auto* complex = registry.try_get<ComplexCollider>(target); complex && complex->points.size() >= 3) {
+        // World-space polygon grown by the projectile radius: each edge pushed
+        // out along its normal, plus a circle of that radius on each vertex.
+        const auto* orientation = registry.try_get<Orientation>(target);
+        const float radians = orientation ? orientation->rotation * 3.14159265f / 180.f : 0.f;
+        const Vector2f scale = orientation ? orientation->scale : Vector2f(1.f, 1.f);
+        const float cosine = std::cos(radians);
+        const float sine = std::sin(radians);
+        std::vector<Vector2f> points;
+        points.reserve(complex->points.size());
+        for (const Vector2f& point : complex->points) {
+            const Vector2f scaled(point.x * scale.x, point.y * scale.y);
+            points.emplace_back(transform->position.x + scaled.x * cosine - scaled.y * sine,
+                transform->position.y + scaled.x * sine + scaled.y * cosine);
+        }
+        const size_t count = points.size();
+        float winding = 0.f;
+        for (size_t i = 0; i < count; ++i) {
+            const Vector2f& p0 = points[i];
+            const Vector2f& p1 = points[(i + 1) % count];
+            winding += (p1.x - p0.x) * (p1.y + p0.y);
+        }
+        // A start inside the polygon (on the inner side of every edge) or
+        // closer than radius to one of its edges hits at once.
+        bool inside = true;
+        bool touching = false;
+        for (size_t i = 0; i < count; ++i) {
+            const Vector2f& p0 = points[i];
+            const Vector2f& p1 = points[(i + 1) % count];
+            const Vector2f edge = p1 - p0;
+            const float lengthSq = edge.x * edge.x + edge.y * edge.y;
+            if (lengthSq == 0.f)
+                continue;
+            const float length = std::sqrt(lengthSq);
+            // Outward normal for either winding order.
+            Vector2f normal(edge.y / length, -edge.x / length);
+            if (winding > 0.f)
+                normal = -normal;
+            const Vector2f toStart = a - p0;
+            if (toStart.x * normal.x + toStart.y * normal.y >= 0.f)
+                inside = false;
+            const float along = std::clamp((toStart.x * edge.x + toStart.y * edge.y) / lengthSq, 0.f, 1.f);
+            const Vector2f offset = toStart - edge * along;
+            if (offset.x * offset.x + offset.y * offset.y < radius * radius)
+                touching = true;
+
+            keepEarliest(earliest, Physics::LineIntersect(a, b, p0 + normal * radius, p1 + normal * radius));
+            if (radius > 0.f)
+                keepEarliest(earliest, Physics::SweepCircle(a, b, p0, radius));
+        }
+        if (inside || touching)
+            earliest = { true, a, 0.f };
+    }
+    return earliest;
+}
+
+const std::vector<ContinuousCollision::Hit>& ContinuousCollision::sweep(const entt::registry& registry,
+    const Broadphase& broadphase, JobSystem& jobs) {
+    m_projectiles.clear();
+    for (auto entity : registry.view<Transform2D, TBullet>())
+        m_projectiles.push_back(entity);
+    for (auto entity : registry.view<Transform2D, TProjectile>(entt::exclude<TBullet>))
+        m_projectiles.push_back(entity);
+    std::sort(m_projectiles.begin(), m_projectiles.end(),
+        [](entt::entity lhs, entt::entity rhs) { return entityIndex(lhs) < entityIndex(rhs); });
+
+    // Each projectile writes only its own slot.
+    m_results.assign(m_projectiles.size(), Hit{});
+    const SpatialGrid& grid = broadphase.grid();
+    jobs.parallelFor(0, m_projectiles.size(), sweepGrain, [&](size_t first, size_t last) {
+        std::vector<entt::entity> candidates;
+        for (size_t i = first; i < last; ++i) {
+            const entt::entity projectile = m_projectiles[i];
+            const auto& transform = registry.get<Transform2D>(projectile);
+            const auto* circle = registry.try_get<CircleCollider>(projectile);
+            const Vector2f offset = circle ? circle->offset : Vector2f(0.f, 0.f);
+            const float radius = circle ? circle->radius : 0.f;
+            const Vector2f a = transform.prevPosition + offset;
+            const Vector2f b = transform.position + offset;
+
+            const Vector2f min(std::min(a.x, b.x) - radius, std::min(a.y, b.y) - radius);
+            const Vector2f max(std::max(a.x, b.x) + radius, std::max(a.y, b.y) + radius);
+            candidates.clear();
+            grid.query(sf::FloatRect(min, max - min), candidates);
+
+            Hit& result = m_results[i];
+            for (entt::entity target : candidates) {
+                if (target == projectile || isProjectile(registry, target))
+                    continue;
+                const Intersect hit = sweepTarget(registry, target, a, b, radius);
+                if (!hit.intersect)
+                    continue;
+                // Earliest impact; the lower entity index breaks ties.
+                if (result.target == entt::null || hit.time < result.time ||
+                    (hit.time == result.time && entityIndex(target) < entityIndex(result.target)))
+                    result = { projectile, target, hit.time, hit.position - offset };
+            }
+        }
+    });
+
+    m_hits.clear();
+    for (const Hit& result : m_results) {
+        if (result.target != entt::null)
+            m_hits.push_back(result);
+    }
+    return m_hits;
+}
+
+const std::vector<ContinuousCollision::Hit>& ContinuousCollision::hits() const {
+    return m_hits;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#ifndef CONTINUOUS_COLLISION_H
+#define CONTINUOUS_COLLISION_H
+
+#include <vector>
+#include <entt/entt.hpp>
+#include "Broadphase.h"
+#include "Components.hpp"
+#include "JobSystem.h"
+#include "Physics.h"
+
+// ContinuousCollision sweeps fast projectiles (TBullet and TProjectile
+// entities) from prevPosition to position, so a projectile that moves further
+// than a target's size in one tick still hits it instead of tunnelling.
+//
+// Each sweep queries the Broadphase grid with the box around the swept
+// segment, then tests the candidates with Physics::SweepBox, SweepCircle and
+// LineIntersect. A projectile with a CircleCollider is swept as a circle by
+// growing each target by its radius: circles stay circles, polygons get
+// rounded corners (a circle on each vertex), and boxes are grown as boxes,
+// so their corners are slightly too large. Targets are tested where they are at the end of
+// the tick, and other projectiles are never targets. Projectiles are swept
+// in parallel batches and each reports only its earliest hit.
+class ContinuousCollision {
+public:
+    struct Hit {
+        entt::entity projectile = entt::null;
+        entt::entity target = entt::null;
+        float time = 0.f;          // Fraction of the tick's movement before impact.
+        Vector2f point{ 0.f, 0.f }; // Projectile centre at impact.
+    };
+
+    // Sweep every projectile; hits are ordered by projectile entity index.
+    const std::vector<Hit>& sweep(const entt::registry& registry, const Broadphase& broadphase, JobSystem& jobs);
+    [[nodiscard]] const std::vector<Hit>& hits() const;
+
+    // Earliest hit of a circle of the given radius (0 for a point) moving
+    // from a to b against the colliders of target.
+    [[nodiscard]] static Intersect sweepTarget(const entt::registry& registry, entt::entity target,
+        const Vector2f& a, const Vector2f& b, float radius);
+
+private:
+    std::vector<entt::entity> m_projectiles;
+    std::vector<Hit> m_results; // One slot per projectile; target is null on a miss.
+    std::vector<Hit> m_hits;
+};
+
+#endif // CONTINUOUS_COLLISION_H
@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <iostream>
 #include <optional>
+#include <utility>
 #include <cstdint> // Include for uint32_t
 #include "imgui.h"
 #include "imgui-SFML.h"
@@ -7,20 +9,45 @@
 #include "SFML/Graphics.hpp"
 #include "GameEngine.h"
 #include "Scene_Menu.h"
+#include "Scene_Galaxy.h"
 #include "ConfigManager.h"
 #include "Action.h"
 #include "Logger.h"
+#include "Profiler.h"
 
 
+// Longest sleep between frames while idle, so fixed ticks and loading still progress.
+static const sf::Time idleWait = sf::milliseconds(100);
+// Frames drawn after an event or scene change even if the scene stays clean.
+static constexpr size_t settleFrames = 3;
+
 // Constructor: load configuration and initialize engine.
-GameEngine::GameEngine(const std::string& configPath) {
+GameEngine::GameEngine(const std::string& configPath, const std::vector<std::string>& args) {
     m_configManager = std::make_unique<ConfigManager>();
-    init(configPath);
+    init(configPath, args);
 }
 
-int GameEngine::init(const std::string& configPath) {
+int GameEngine::init(const std::string& configPath, const std::vector<std::string>& args) {
     EngineConfig config = m_configManager->load(configPath);
-    m_assets.loadFromFile(config.assetConfigPath);
+    m_configManager->applyArguments(config, args);
+    Profiler::getInstance().setThreadName("Main");
+    Profiler::getInstance().setEnabled(config.profiler);
+    m_jobs = std::make_unique<JobSystem>(config.workerThreads);
+
+    m_tickTime = sf::seconds(1.f / static_cast<float>(std::max(config.simulationRate, 1u)));
+    m_simulationSpeed = std::max<size_t>(config.simulationSpeed, 1);
+    m_maxTicksPerFrame = std::max<size_t>(config.maxTicksPerFrame, 1);
+    m_idleRendering = config.idleRendering;
+
+    if (config.headless) {
+        // Textures, fonts and sounds need a GL context and an audio device,
+        // so headless runs skip asset loading and go straight to the galaxy.
+        m_headless = true;
+        m_headlessTicks = config.headlessTicks;
+        m_headlessSize = { config.windowWidth, config.windowHeight };
+        changeScene("Galaxy View", std::make_shared<Scene_Galaxy>(this));
+        return 0;
+    }
 
     // SFML 3.0 window style handling
     if (config.fullscreen)
@@ -28,6 +55,8 @@ int GameEngine::init(const std::string& configPath) {
     else
         m_window.create(sf::VideoMode({ config.windowWidth, config.windowHeight }), "AstralReign", sf::State::Windowed);
 
+    m_assets.loadFromFile(config.assetConfigPath, *m_jobs);
+
     m_window.setFramerateLimit(config.frameRateLimit);
     m_window.setVerticalSyncEnabled(true);
 
@@ -41,6 +70,7 @@ int GameEngine::init(const std::string& configPath) {
         std::cerr << "Failed ImGui initialization\n";
     }
 
+    m_renderer = std::make_unique<Renderer>(m_window, config.renderThread);
     changeScene("MENU", std::make_shared<Scene_Menu>(this));
     return 0;
 }
@@ -50,27 +80,106 @@ std::shared_ptr<Scene> GameEngine::currentScene() {
 }
 
 bool GameEngine::isRunning() {
-    return m_running && m_window.isOpen();
+    return m_running && (m_headless || m_window.isOpen());
+}
+
+bool GameEngine::isHeadless() const {
+    return m_headless;
 }
 
 sf::RenderWindow& GameEngine::window() {
     return m_window;
 }
 
+sf::Vector2u GameEngine::viewSize() const {
+    return m_headless ? m_headlessSize : m_window.getSize();
+}
+
+RenderPacket& GameEngine::renderPacket() {
+    return m_renderer->packet();
+}
+
 void GameEngine::run() {
+    if (m_headless) {
+        runHeadless();
+        return;
+    }
+
     while (isRunning()) {
-        sUserInput();
-        ImGui::SFML::Update(m_window, m_deltaClock.restart());
-        update();
-        ImGui::SFML::Render(m_window);
-        m_window.display();
+        Profiler::getInstance().beginFrame();
+        sf::Time frameTime = m_deltaClock.restart();
+        {
+            PROFILE_SCOPE("sUserInput");
+            sUserInput(m_idle ? idleWait : sf::Time::Zero);
+        }
+        m_jobs->pumpMainThread();
+        if (m_sceneLoad.valid() && m_sceneLoad.finished()) {
+            // Surfaces any exception thrown while building the scene.
+            JobHandle load = std::exchange(m_sceneLoad, JobHandle());
+            m_jobs->wait(load);
+        }
+        // Simulate while the render thread is still drawing the previous frame.
+        update(frameTime);
+
+        // Nothing changed: the window keeps showing the last presented frame.
+        m_idle = !needsRedraw();
+        if (m_idle) {
+            Profiler::getInstance().endFrame();
+            continue;
+        }
+
+        {
+            PROFILE_SCOPE("Renderer::beginFrame");
+            m_renderer->beginFrame();
+        }
+        for (const auto& event : m_imguiEvents)
+            ImGui::SFML::ProcessEvent(m_window, event);
+        m_imguiEvents.clear();
+        ImGui::SFML::Update(m_window, m_imguiClock.restart());
+        {
+            PROFILE_SCOPE("Scene::sRender");
+            currentScene()->sRender();
+            currentScene()->submitLines(m_renderer->packet());
+            currentScene()->clearDirty();
+        }
+        if (m_redrawFrames > 0)
+            --m_redrawFrames;
+        drawLoadingOverlay();
+        Profiler::getInstance().drawImGui();
+        m_renderer->submit();
+        Profiler::getInstance().endFrame();
     }
+
+    m_renderer->stop();
+    m_window.close();
 }
 
-void GameEngine::sUserInput() {
-    std::optional<sf::Event> eventOpt;
-    while ((eventOpt = m_window.pollEvent())) {
-        ImGui::SFML::ProcessEvent(m_window, *eventOpt);
+void GameEngine::runHeadless() {
+    sf::Clock clock;
+    const size_t startFrame = currentScene()->currentFrame();
+    currentScene()->simulate(m_headlessTicks);
+    const size_t ticks = currentScene()->currentFrame() - startFrame;
+    const float seconds = clock.getElapsedTime().asSeconds();
+
+    // Always reported (not LOG) since this is the output of a batch run.
+    std::cout << "Headless run: " << ticks << " ticks in " << seconds << " s ("
+        << (seconds > 0.f ? static_cast<float>(ticks) / seconds : 0.f) << " ticks/s)" << std::endl;
+    m_running = false;
+}
+
+bool GameEngine::needsRedraw() {
+    if (!m_idleRendering || m_redrawFrames > 0 || isLoading() || Profiler::getInstance().isEnabled())
+        return true;
+    const auto scene = currentScene();
+    return scene->isDirty() || scene->isAnimating();
+}
+
+void GameEngine::sUserInput(sf::Time wait) {
+    std::optional<sf::Event> eventOpt = wait > sf::Time::Zero ? m_window.waitEvent(wait) : m_window.pollEvent();
+    for (; eventOpt; eventOpt = m_window.pollEvent()) {
+        m_imguiEvents.push_back(*eventOpt);
+        // Any event may change ImGui or the window contents.
+        m_redrawFrames = settleFrames;
 
         if (auto* closeEvent = eventOpt->getIf<sf::Event::Closed>()) {
             LOG("Window close event detected");
@@ -80,6 +189,11 @@ void GameEngine::sUserInput() {
 
         if (auto* keyEvent = eventOpt->getIf<sf::Event::KeyPressed>()) {
             LOG("Key pressed: " + std::to_string(static_cast<int>(keyEvent->code)));
+            // Engine-wide toggle, independent of the scene's action map.
+            if (keyEvent->code == sf::Keyboard::Key::F3) {
+                Profiler::getInstance().setEnabled(!Profiler::getInstance().isEnabled());
+                continue;
+            }
             ActionType type = ActionType::Start;
             int key = static_cast<int>(keyEvent->code);
             const auto& actionMap = currentScene()->getActionMap();
@@ -137,15 +251,93 @@ void GameEngine::sUserInput() {
 void GameEngine::changeScene(const std::string& sceneName, std::shared_ptr<Scene> scene, bool /*endCurrentScene*/) {
     m_currentScene = sceneName;
     m_sceneMap[sceneName] = std::move(scene);
+    m_sceneMap[sceneName]->onActivate();
+    m_redrawFrames = settleFrames;
+}
+
+void GameEngine::changeSceneAsync(const std::string& sceneName, SceneFactory factory) {
+    if (isLoading()) {
+        LOG("Ignoring scene change to " + sceneName + " while " + m_loadingScene + " is loading");
+        return;
+    }
+
+    m_loadingScene = sceneName;
+    m_loadProgress = 0.f;
+
+    // The scene is built off-thread; only the swap and its onActivate()
+    // (audio, view and GPU work) run on the main thread.
+    auto scene = std::make_shared<std::shared_ptr<Scene>>();
+    JobHandle build = m_jobs->schedule([scene, factory = std::move(factory)] {
+        PROFILE_SCOPE("Scene construction");
+        *scene = factory();
+    });
+    m_sceneLoad = m_jobs->scheduleMain([this, build, scene, sceneName] {
+        m_jobs->wait(build); // Already finished; rethrows construction errors.
+        m_loadProgress = 1.f;
+        changeScene(sceneName, std::move(*scene));
+    }, { build });
+}
+
+bool GameEngine::isLoading() const {
+    return m_sceneLoad.valid() && !m_sceneLoad.finished();
+}
+
+void GameEngine::setLoadProgress(float progress) {
+    m_loadProgress = std::clamp(progress, 0.f, 1.f);
+}
+
+void GameEngine::drawLoadingOverlay() {
+    if (!isLoading())
+        return;
+
+    const ImVec2 displaySize = ImGui::GetIO().DisplaySize;
+    ImGui::SetNextWindowPos(ImVec2(displaySize.x * 0.5f, displaySize.y * 0.8f), ImGuiCond_Always, ImVec2(0.5f, 0.5f));
+    ImGui::Begin("Loading", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+        ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoInputs);
+    ImGui::Text("Loading %s...", m_loadingScene.c_str());
+    ImGui::ProgressBar(m_loadProgress.load(), ImVec2(400.f, 0.f));
+    ImGui::End();
 }
 
+// The window is closed by run() once the renderer has stopped using it.
 void GameEngine::quit() {
     m_running = false;
-    m_window.close();
 }
 
-void GameEngine::update() {
-    currentScene()->update();
+void GameEngine::update(sf::Time frameTime) {
+    // Ignore huge stalls (debugger breaks, window drags) instead of replaying them.
+    const sf::Time maxFrameTime = sf::seconds(0.25f);
+    m_accumulator += std::min(frameTime, maxFrameTime) * static_cast<float>(m_simulationSpeed);
+
+    // Faster game speeds are allowed proportionally more ticks per frame so the
+    // galaxy clock keeps pace; the cap only kicks in when rendering stalls.
+    const size_t maxTicks = m_maxTicksPerFrame * m_simulationSpeed;
+    size_t ticks = 0;
+    while (m_accumulator >= m_tickTime && ticks < maxTicks) {
+        PROFILE_SCOPE("Scene::update");
+        currentScene()->update();
+        m_accumulator -= m_tickTime;
+        ++ticks;
+    }
+    if (ticks == maxTicks && m_accumulator >= m_tickTime) {
+        LOG("Simulation fell behind; dropping " + std::to_string(m_accumulator / m_tickTime) + " ticks");
+        m_accumulator = sf::Time::Zero;
+    }
+
+    // Fraction of a tick between the last two simulated states, used by sRender.
+    currentScene()->setInterpolation(m_accumulator / m_tickTime);
+}
+
+void GameEngine::setSimulationSpeed(size_t speed) {
+    m_simulationSpeed = std::max<size_t>(speed, 1);
+}
+
+size_t GameEngine::simulationSpeed() const {
+    return m_simulationSpeed;
+}
+
+sf::Time GameEngine::tickTime() const {
+    return m_tickTime;
 }
 
 void GameEngine::playSound(const std::string& soundName) {
@@ -159,3 +351,7 @@ void GameEngine::stopSound(const std::string& soundName) {
 Assets& GameEngine::assets() {
     return m_assets;
 }
+
+JobSystem& GameEngine::jobs() {
+    return *m_jobs;
+}
@@ -2,43 +2,98 @@
 #ifndef GAME_ENGINE_H
 #define GAME_ENGINE_H
 
+#include <atomic>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/System/Clock.hpp>
 #include "Scene.h"
 #include "Assets.h"
 #include "ConfigManager.h"
+#include "JobSystem.h"
+#include "Renderer.h"
 
 // Mapping from scene name to scene pointer.
 using SceneMap = std::map<std::string, std::shared_ptr<Scene>>;
 
+// Builds a scene; run on a worker thread by changeSceneAsync.
+using SceneFactory = std::function<std::shared_ptr<Scene>()>;
+
 class GameEngine {
 protected:
     sf::RenderWindow m_window;
     sf::Clock        m_deltaClock;
+    sf::Clock        m_imguiClock; // Time since the last rendered (ImGui) frame.
     Assets           m_assets;
     std::string      m_currentScene;
     SceneMap         m_sceneMap;
     size_t           m_simulationSpeed = 1;
     bool             m_running = true;
 
+    // Fixed-timestep state: game time per tick, unsimulated time carried
+    // between frames, and the catch-up limit per rendered frame (at 1x speed).
+    sf::Time         m_tickTime = sf::seconds(1.f / 60.f);
+    sf::Time         m_accumulator = sf::Time::Zero;
+    size_t           m_maxTicksPerFrame = 8;
+
+    // Headless runs have no window, ImGui or audio and only call Scene::simulate.
+    bool             m_headless = false;
+    size_t           m_headlessTicks = 0;
+    sf::Vector2u     m_headlessSize; // Stands in for the window size (from config).
+
+    // Scene being built in the background by changeSceneAsync, if any.
+    JobHandle         m_sceneLoad;
+    std::atomic<float> m_loadProgress{ 0.f };
+    std::string       m_loadingScene;
+
+    // Work-stealing pool shared by every subsystem; declared after the scenes
+    // and assets so its workers are joined before anything they use is destroyed.
+    std::unique_ptr<JobSystem> m_jobs;
+
+    // Draws submitted frames, on its own thread when enabled. Declared last so
+    // it stops drawing before the scenes and assets its packets refer to go away.
+    std::unique_ptr<Renderer> m_renderer;
+    // Events for ImGui, held back until the renderer is done with ImGui's last frame.
+    std::vector<sf::Event> m_imguiEvents;
+
+    // Idle rendering: frames are only drawn when something changed. After
+    // input or a scene change a few frames are drawn so ImGui can settle.
+    bool             m_idleRendering = true;
+    bool             m_idle = false;
+    size_t           m_redrawFrames = 0;
+
     // New: configuration manager instance.
     std::unique_ptr<ConfigManager> m_configManager;
 
-    // Initialize the engine using configuration from configPath.
-    int init(const std::string& configPath);
-    void update();
-    void sUserInput();
+    // Initialize the engine using configuration from configPath and command-line overrides.
+    int init(const std::string& configPath, const std::vector<std::string>& args);
+    void runHeadless();
+    void drawLoadingOverlay();
+    // Run as many fixed simulation ticks as the elapsed frame time allows.
+    void update(sf::Time frameTime);
+    // Handle pending window events; waits up to wait for the first one.
+    void sUserInput(sf::Time wait = sf::Time::Zero);
+    [[nodiscard]] bool needsRedraw();
     std::shared_ptr<Scene> currentScene();
 
 public:
-    // The constructor now accepts a configuration file path.
-    explicit GameEngine(const std::string& configPath);
+    // The constructor accepts a configuration file path and optional command-line arguments.
+    explicit GameEngine(const std::string& configPath, const std::vector<std::string>& args = {});
 
     // Scene management
     void changeScene(const std::string& sceneName, std::shared_ptr<Scene> scene, bool endCurrentScene = false);
+
+    // Build a scene on a worker while the current one keeps running and
+    // rendering, then switch to it at the start of a frame on the main thread.
+    // Ignored while another scene is still loading.
+    void changeSceneAsync(const std::string& sceneName, SceneFactory factory);
+    [[nodiscard]] bool isLoading() const;
+
+    // Report construction progress in [0, 1] from a scene being built (any thread).
+    void setLoadProgress(float progress);
     void quit();
     void run();
 
@@ -48,8 +103,21 @@ public:
 
     // Accessors.
     sf::RenderWindow& window();
+    // Size of the window, or of the configured window when headless.
+    [[nodiscard]] sf::Vector2u viewSize() const;
+    // Draw commands for the frame being recorded; scenes draw here in sRender.
+    RenderPacket& renderPacket();
     Assets& assets();
+    JobSystem& jobs();
     bool isRunning();
+    [[nodiscard]] bool isHeadless() const;
+
+    // Simulated time per update() of the current scene.
+    [[nodiscard]] sf::Time tickTime() const;
+
+    // Game time multiplier (1 = real time).
+    void setSimulationSpeed(size_t speed);
+    [[nodiscard]] size_t simulationSpeed() const;
 };
 
 #endif // GAME_ENGINE_H
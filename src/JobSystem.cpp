@@ -0,0 +1,210 @@
+#include <string>
+#include "JobSystem.h"
+#include "Profiler.h"
+
+namespace {
+    // Index of the worker owning the current thread (npos for non-workers).
+    constexpr size_t npos = static_cast<size_t>(-1);
+    thread_local size_t t_workerIndex = npos;
+}
+
+JobSystem::JobSystem(size_t workerCount)
+    : m_mainThread(std::this_thread::get_id())
+{
+    if (workerCount == 0) {
+        const unsigned int hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    for (size_t i = 0; i < workerCount; ++i)
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    for (size_t i = 0; i < workerCount; ++i)
+        m_workers.emplace_back([this, i] { workerLoop(i); });
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_running = false;
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers)
+        worker.join();
+}
+
+JobHandle JobSystem::schedule(std::function<void()> fn, const std::vector<JobHandle>& dependencies) {
+    return submit(std::move(fn), dependencies, false);
+}
+
+JobHandle JobSystem::then(const JobHandle& job, std::function<void()> fn) {
+    return submit(std::move(fn), { job }, false);
+}
+
+JobHandle JobSystem::scheduleMain(std::function<void()> fn, const std::vector<JobHandle>& dependencies) {
+    return submit(std::move(fn), dependencies, true);
+}
+
+void JobSystem::runOnMainThread(std::function<void()> fn) {
+    submit(std::move(fn), {}, true);
+}
+
+JobHandle JobSystem::submit(std::function<void()> fn, const std::vector<JobHandle>& dependencies, bool mainThread) {
+    auto job = std::make_shared<Job>();
+    job->fn = std::move(fn);
+    job->mainThread = mainThread;
+
+    // One extra count keeps the job from starting while dependencies are wired up.
+    job->dependencies.store(dependencies.size() + 1, std::memory_order_relaxed);
+    for (const auto& dependency : dependencies) {
+        if (!dependency.m_job) {
+            job->dependencies.fetch_sub(1, std::memory_order_relaxed);
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(dependency.m_job->mutex);
+        if (dependency.m_job->finished.load(std::memory_order_acquire))
+            job->dependencies.fetch_sub(1, std::memory_order_relaxed);
+        else
+            dependency.m_job->continuations.push_back(job);
+    }
+    if (job->dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        enqueue(job);
+
+    return JobHandle(job);
+}
+
+void JobSystem::enqueue(const std::shared_ptr<Job>& job) {
+    if (job->mainThread) {
+        std::lock_guard<std::mutex> lock(m_mainMutex);
+        m_mainJobs.push_back(job);
+        return;
+    }
+
+    // Workers keep their own jobs local; other threads spread work round-robin.
+    size_t index = t_workerIndex != npos ? t_workerIndex : m_nextQueue.fetch_add(1) % m_queues.size();
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->jobs.push_back(job);
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_queued.fetch_add(1, std::memory_order_release);
+    }
+    m_wake.notify_one();
+}
+
+std::shared_ptr<JobSystem::Job> JobSystem::takeJob(size_t preferred) {
+    const size_t count = m_queues.size();
+    if (preferred != npos) {
+        auto& own = *m_queues[preferred];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            auto job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+
+    // Steal the oldest job from another queue.
+    const size_t start = preferred != npos ? preferred + 1 : m_nextQueue.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        auto& victim = *m_queues[(start + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            auto job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::execute(const std::shared_ptr<Job>& job) {
+    try {
+        job->fn();
+    }
+    catch (...) {
+        job->error = std::current_exception();
+    }
+    job->fn = nullptr;
+
+    std::vector<std::shared_ptr<Job>> continuations;
+    {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        job->finished.store(true, std::memory_order_release);
+        continuations.swap(job->continuations);
+    }
+    for (auto& continuation : continuations) {
+        if (continuation->dependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            enqueue(continuation);
+    }
+}
+
+void JobSystem::workerLoop(size_t index) {
+    t_workerIndex = index;
+    Profiler::getInstance().setThreadName("Worker " + std::to_string(index));
+    while (true) {
+        if (auto job = takeJob(index)) {
+            execute(job);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this] { return !m_running || m_queued.load(std::memory_order_acquire) > 0; });
+        if (!m_running)
+            return;
+    }
+}
+
+void JobSystem::pumpMainThread() {
+    std::vector<std::shared_ptr<Job>> jobs;
+    {
+        std::lock_guard<std::mutex> lock(m_mainMutex);
+        jobs.swap(m_mainJobs);
+    }
+    for (auto& job : jobs)
+        execute(job);
+}
+
+void JobSystem::wait(const JobHandle& handle) {
+    if (!handle.m_job)
+        return;
+
+    const bool mainThread = isMainThread();
+    while (!handle.m_job->finished.load(std::memory_order_acquire)) {
+        if (auto job = takeJob(t_workerIndex)) {
+            execute(job);
+            continue;
+        }
+        if (mainThread)
+            pumpMainThread();
+        std::this_thread::yield();
+    }
+
+    if (handle.m_job->error)
+        std::rethrow_exception(handle.m_job->error);
+}
+
+void JobSystem::waitAll(const std::vector<JobHandle>& jobs) {
+    // Wait on every job before rethrowing so none is left referencing the caller's stack.
+    std::exception_ptr error;
+    for (const auto& job : jobs) {
+        try {
+            wait(job);
+        }
+        catch (...) {
+            if (!error)
+                error = std::current_exception();
+        }
+    }
+    if (error)
+        std::rethrow_exception(error);
+}
+
+size_t JobSystem::workerCount() const {
+    return m_workers.size();
+}
+
+bool JobSystem::isMainThread() const {
+    return std::this_thread::get_id() == m_mainThread;
+}
@@ -0,0 +1,177 @@
+#pragma once
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <entt/entt.hpp>
+
+// JobSystem is the engine-wide work-stealing thread pool (owned by GameEngine).
+// Each worker has its own deque: it pushes and pops its own jobs LIFO and
+// steals FIFO from the others when it runs dry. Jobs may depend on other jobs
+// and only start once all of them finished. Threads that wait on a job help by
+// running queued jobs, so nested parallelFor calls cannot deadlock.
+//
+// SFML window and GL calls are only legal on the main thread; use
+// scheduleMain()/runOnMainThread() for those, which GameEngine drains every
+// frame through pumpMainThread().
+class JobSystem {
+    struct Job {
+        std::function<void()> fn;
+        std::atomic<size_t> dependencies{ 0 };
+        std::atomic<bool> finished{ false };
+        std::mutex mutex; // Guards continuations and the finished transition.
+        std::vector<std::shared_ptr<Job>> continuations;
+        std::exception_ptr error;
+        bool mainThread = false;
+    };
+
+public:
+    // Lightweight reference to a scheduled job.
+    class JobHandle {
+        friend class JobSystem;
+        std::shared_ptr<Job> m_job;
+        explicit JobHandle(std::shared_ptr<Job> job) : m_job(std::move(job)) {}
+    public:
+        JobHandle() = default;
+        [[nodiscard]] bool valid() const { return m_job != nullptr; }
+        [[nodiscard]] bool finished() const { return !m_job || m_job->finished.load(std::memory_order_acquire); }
+    };
+
+    // workerCount 0 picks hardware_concurrency() - 1 (the main thread helps while waiting).
+    explicit JobSystem(size_t workerCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Schedule fn on a worker once every dependency has finished.
+    JobHandle schedule(std::function<void()> fn, const std::vector<JobHandle>& dependencies = {});
+
+    // Schedule fn to run after job (a continuation).
+    JobHandle then(const JobHandle& job, std::function<void()> fn);
+
+    // Schedule fn on the main-thread queue once every dependency has finished.
+    JobHandle scheduleMain(std::function<void()> fn, const std::vector<JobHandle>& dependencies = {});
+    void runOnMainThread(std::function<void()> fn);
+
+    // Run all main-thread jobs that are ready. Must be called from the main thread.
+    void pumpMainThread();
+
+    // Block until job finished, running other jobs meanwhile. Rethrows the job's exception.
+    void wait(const JobHandle& job);
+    void waitAll(const std::vector<JobHandle>& jobs);
+
+    [[nodiscard]] size_t workerCount() const;
+    [[nodiscard]] bool isMainThread() const;
+
+    // Call fn(first, last) over [begin, end) split into chunks of at least grain items.
+    template <typename Func>
+    void parallelFor(size_t begin, size_t end, size_t grain, Func&& fn) {
+        if (begin >= end)
+            return;
+        grain = std::max<size_t>(grain, 1);
+        const size_t count = end - begin;
+        const size_t maxChunks = (m_workers.size() + 1) * 4;
+        const size_t chunks = std::min(maxChunks, (count + grain - 1) / grain);
+        if (chunks <= 1) {
+            fn(begin, end);
+            return;
+        }
+
+        const size_t chunkSize = (count + chunks - 1) / chunks;
+        std::vector<JobHandle> jobs;
+        jobs.reserve(chunks - 1);
+        try {
+            for (size_t first = begin + chunkSize; first < end; first += chunkSize) {
+                const size_t last = std::min(end, first + chunkSize);
+                jobs.push_back(schedule([&fn, first, last] { fn(first, last); }));
+            }
+            fn(begin, std::min(end, begin + chunkSize));
+        }
+        catch (...) {
+            // The jobs reference fn; let them finish before unwinding past it.
+            try {
+                waitAll(jobs);
+            }
+            catch (...) {
+            }
+            throw;
+        }
+        waitAll(jobs);
+    }
+
+    // Call fn(entity) for every entity of an entt view, group or storage, in parallel.
+    // fn must only touch components of the entity it was given.
+    template <typename Range, typename Func>
+    void parallelEach(const Range& range, Func&& fn, size_t grain = 256) {
+        if constexpr (std::is_base_of_v<entt::sparse_set, Range>) {
+            // Raw storage: may contain tombstones when components are deleted in place.
+            parallelFor(0, range.size(), grain, [&](size_t first, size_t last) {
+                for (size_t i = first; i < last; ++i) {
+                    const auto entity = range.data()[i];
+                    if (range.contains(entity))
+                        fn(entity);
+                }
+            });
+        }
+        else if constexpr (std::is_pointer_v<decltype(range.handle())>) {
+            // View: walk the leading storage and filter on the other components.
+            const auto* handle = range.handle();
+            if (!handle)
+                return;
+            parallelFor(0, handle->size(), grain, [&](size_t first, size_t last) {
+                for (size_t i = first; i < last; ++i) {
+                    const auto entity = handle->data()[i];
+                    if (range.contains(entity))
+                        fn(entity);
+                }
+            });
+        }
+        else {
+            // Group: its first size() handle entries are exactly the members.
+            const auto& handle = range.handle();
+            parallelFor(0, range.size(), grain, [&](size_t first, size_t last) {
+                for (size_t i = first; i < last; ++i)
+                    fn(handle.data()[i]);
+            });
+        }
+    }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<Job>> jobs;
+    };
+
+    JobHandle submit(std::function<void()> fn, const std::vector<JobHandle>& dependencies, bool mainThread);
+    void enqueue(const std::shared_ptr<Job>& job);
+    std::shared_ptr<Job> takeJob(size_t preferred);
+    void execute(const std::shared_ptr<Job>& job);
+    void workerLoop(size_t index);
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::atomic<size_t> m_nextQueue{ 0 };
+    std::atomic<size_t> m_queued{ 0 };
+    std::atomic<bool> m_running{ true };
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+
+    std::mutex m_mainMutex;
+    std::vector<std::shared_ptr<Job>> m_mainJobs;
+    std::thread::id m_mainThread;
+};
+
+using JobHandle = JobSystem::JobHandle;
+
+#endif // JOB_SYSTEM_H
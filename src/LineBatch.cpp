@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <cmath>
+#include "LineBatch.h"
+
+void LineBatch::add(const Vector2f& p1, const Vector2f& p2, sf::Color color, float width, int layer) {
+    Layer& target = m_layers[layer];
+    if (width <= 0.f) {
+        target.lines.push_back({ p1, color });
+        target.lines.push_back({ p2, color });
+        m_segmentCount++;
+        return;
+    }
+
+    const Vector2f delta = p2 - p1;
+    const float length = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+    if (length <= 0.f)
+        return;
+    // Offset both ends by half the width along the segment's normal.
+    const Vector2f normal(-delta.y / length * width / 2.f, delta.x / length * width / 2.f);
+    const sf::Vertex a{ p1 + normal, color };
+    const sf::Vertex b{ p2 + normal, color };
+    const sf::Vertex c{ p2 - normal, color };
+    const sf::Vertex d{ p1 - normal, color };
+    target.triangles.insert(target.triangles.end(), { a, b, c, a, c, d });
+    m_segmentCount++;
+}
+
+void LineBatch::cull(std::vector<sf::Vertex>& vertices, size_t stride, const sf::FloatRect& view) {
+    const Vector2f viewMax = view.position + view.size;
+    size_t kept = 0;
+    for (size_t first = 0; first < vertices.size(); first += stride) {
+        // A wide line's quad corners already include its width.
+        Vector2f min = vertices[first].position;
+        Vector2f max = min;
+        for (size_t i = first + 1; i < first + stride; ++i) {
+            const Vector2f& position = vertices[i].position;
+            min = { std::min(min.x, position.x), std::min(min.y, position.y) };
+            max = { std::max(max.x, position.x), std::max(max.y, position.y) };
+        }
+        if (max.x < view.position.x || min.x > viewMax.x || max.y < view.position.y || min.y > viewMax.y)
+            continue;
+        if (kept != first)
+            std::copy(vertices.begin() + first, vertices.begin() + first + stride, vertices.begin() + kept);
+        kept += stride;
+    }
+    vertices.resize(kept);
+}
+
+void LineBatch::submit(RenderPacket& packet, Layer& layer) {
+    m_segmentCount -= layer.lines.size() / 2 + layer.triangles.size() / 6;
+    // World-space bounds of the view being recorded, rotation included.
+    const sf::View& view = packet.view();
+    const sf::FloatRect bounds = view.getInverseTransform().transformRect(sf::FloatRect({ -1.f, -1.f }, { 2.f, 2.f }));
+    cull(layer.lines, 2, bounds);
+    cull(layer.triangles, 6, bounds);
+    packet.draw(layer.lines.data(), layer.lines.size(), sf::PrimitiveType::Lines);
+    packet.draw(layer.triangles.data(), layer.triangles.size(), sf::PrimitiveType::Triangles);
+    layer.lines.clear();
+    layer.triangles.clear();
+}
+
+void LineBatch::submit(RenderPacket& packet, int layer) {
+    auto it = m_layers.find(layer);
+    if (it != m_layers.end())
+        submit(packet, it->second);
+}
+
+void LineBatch::submit(RenderPacket& packet) {
+    for (auto& [index, layer] : m_layers)
+        submit(packet, layer);
+}
+
+void LineBatch::layers(std::vector<int>& out) const {
+    for (const auto& [index, layer] : m_layers) {
+        if (!layer.lines.empty() || !layer.triangles.empty())
+            out.push_back(index);
+    }
+}
+
+void LineBatch::clear() {
+    for (auto& [index, layer] : m_layers) {
+        layer.lines.clear();
+        layer.triangles.clear();
+    }
+    m_segmentCount = 0;
+}
+
+size_t LineBatch::segmentCount() const {
+    return m_segmentCount;
+}
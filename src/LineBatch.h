@@ -0,0 +1,50 @@
+#pragma once
+#ifndef LINE_BATCH_H
+#define LINE_BATCH_H
+
+#include <map>
+#include <vector>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include "RenderPacket.h"
+
+using sf::Vector2f;
+
+// LineBatch accumulates line segments for a frame and submits them as at most
+// two draws per layer: one Lines draw for hairlines (width 0) and one
+// Triangles draw for wide lines, which are expanded into quads on the CPU.
+// Segments entirely outside the packet's current view are dropped when they
+// are submitted.
+class LineBatch {
+public:
+    // width is in world units; 0 draws a one-pixel hairline.
+    void add(const Vector2f& p1, const Vector2f& p2, sf::Color color = sf::Color::White, float width = 0.f, int layer = 0);
+
+    // Record and drop the segments of one layer, or of every layer in order.
+    void submit(RenderPacket& packet, int layer);
+    void submit(RenderPacket& packet);
+
+    // Append the layers that have segments, in ascending order.
+    void layers(std::vector<int>& out) const;
+
+    // Drop all segments (keeps allocated memory).
+    void clear();
+
+    [[nodiscard]] size_t segmentCount() const;
+
+private:
+    struct Layer {
+        std::vector<sf::Vertex> lines;     // Two per hairline.
+        std::vector<sf::Vertex> triangles; // Six per wide line.
+    };
+
+    // Keep only the segments (groups of stride vertices) that touch view.
+    static void cull(std::vector<sf::Vertex>& vertices, size_t stride, const sf::FloatRect& view);
+    void submit(RenderPacket& packet, Layer& layer);
+
+    std::map<int, Layer> m_layers;
+    size_t m_segmentCount = 0;
+};
+
+#endif // LINE_BATCH_H
@@ -0,0 +1,149 @@
+#include <cmath>
+#include "LodHierarchy.h"
+
+LodHierarchy::LodHierarchy(float baseCellSize, size_t levels)
+    : m_baseCellSize(baseCellSize)
+    , m_levels(levels > 0 ? levels : 1) {
+}
+
+int32_t LodHierarchy::cellCoord(float value, size_t level) const {
+    return static_cast<int32_t>(std::floor(value / cellSize(level)));
+}
+
+uint64_t LodHierarchy::cellKey(int32_t x, int32_t y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+float LodHierarchy::cellSize(size_t level) const {
+    return std::ldexp(m_baseCellSize, static_cast<int>(level));
+}
+
+size_t LodHierarchy::levelCount() const {
+    return m_levels.size();
+}
+
+size_t LodHierarchy::levelFor(float size) const {
+    size_t level = 0;
+    while (level + 1 < m_levels.size() && cellSize(level) < size)
+        ++level;
+    return level;
+}
+
+void LodHierarchy::add(const Entry& entry, int sign) {
+    for (size_t level = 0; level < m_levels.size(); ++level) {
+        const uint64_t key = cellKey(cellCoord(entry.position.x, level), cellCoord(entry.position.y, level));
+        Cell& cell = m_levels[level][key];
+        cell.x += sign * static_cast<double>(entry.position.x);
+        cell.y += sign * static_cast<double>(entry.position.y);
+        cell.count += static_cast<uint32_t>(sign);
+        cell.r += static_cast<uint32_t>(sign * entry.color.r);
+        cell.g += static_cast<uint32_t>(sign * entry.color.g);
+        cell.b += static_cast<uint32_t>(sign * entry.color.b);
+        if (cell.count == 0)
+            m_levels[level].erase(key);
+    }
+}
+
+void LodHierarchy::insert(entt::entity entity, const sf::Vector2f& position, sf::Color color) {
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= m_entries.size())
+        m_entries.resize(index + 1);
+
+    Entry& entry = m_entries[index];
+    if (entry.entity != entt::null) {
+        // Already present, or a destroyed entity whose index was recycled without remove().
+        add(entry, -1);
+        m_size--;
+    }
+
+    entry = Entry{ entity, position, color };
+    add(entry, 1);
+    m_size++;
+}
+
+void LodHierarchy::update(entt::entity entity, const sf::Vector2f& position) {
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= m_entries.size() || m_entries[index].entity != entity)
+        return;
+
+    Entry& entry = m_entries[index];
+    if (cellCoord(entry.position.x, 0) == cellCoord(position.x, 0) &&
+        cellCoord(entry.position.y, 0) == cellCoord(position.y, 0)) {
+        // Same cell at every level: only the centroid sums change.
+        for (size_t level = 0; level < m_levels.size(); ++level) {
+            Cell& cell = m_levels[level][cellKey(cellCoord(position.x, level), cellCoord(position.y, level))];
+            cell.x += static_cast<double>(position.x) - static_cast<double>(entry.position.x);
+            cell.y += static_cast<double>(position.y) - static_cast<double>(entry.position.y);
+        }
+        entry.position = position;
+        return;
+    }
+
+    add(entry, -1);
+    entry.position = position;
+    add(entry, 1);
+}
+
+void LodHierarchy::remove(entt::entity entity) {
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= m_entries.size() || m_entries[index].entity != entity)
+        return;
+    add(m_entries[index], -1);
+    m_entries[index] = Entry{};
+    m_size--;
+}
+
+sf::Color LodHierarchy::color(entt::entity entity) const {
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= m_entries.size() || m_entries[index].entity != entity)
+        return sf::Color::White;
+    return m_entries[index].color;
+}
+
+void LodHierarchy::query(size_t level, const sf::FloatRect& area, std::vector<Cluster>& out) const {
+    if (level >= m_levels.size())
+        level = m_levels.size() - 1;
+    const auto& cells = m_levels[level];
+    const int32_t minX = cellCoord(area.position.x, level);
+    const int32_t minY = cellCoord(area.position.y, level);
+    const int32_t maxX = cellCoord(area.position.x + area.size.x, level);
+    const int32_t maxY = cellCoord(area.position.y + area.size.y, level);
+
+    auto emit = [&](const Cell& cell) {
+        const double count = static_cast<double>(cell.count);
+        out.push_back({ sf::Vector2f(static_cast<float>(cell.x / count), static_cast<float>(cell.y / count)), cell.count,
+            sf::Color(static_cast<uint8_t>(cell.r / cell.count), static_cast<uint8_t>(cell.g / cell.count),
+                static_cast<uint8_t>(cell.b / cell.count)) });
+    };
+
+    // As in SpatialGrid, walk the stored cells when that is cheaper than probing.
+    const uint64_t span = static_cast<uint64_t>(maxX - minX + 1) * static_cast<uint64_t>(maxY - minY + 1);
+    if (span > cells.size()) {
+        for (const auto& [key, cell] : cells) {
+            const auto x = static_cast<int32_t>(static_cast<uint32_t>(key >> 32));
+            const auto y = static_cast<int32_t>(static_cast<uint32_t>(key));
+            if (x >= minX && x <= maxX && y >= minY && y <= maxY)
+                emit(cell);
+        }
+        return;
+    }
+
+    for (int32_t y = minY; y <= maxY; ++y) {
+        for (int32_t x = minX; x <= maxX; ++x) {
+            auto it = cells.find(cellKey(x, y));
+            if (it != cells.end())
+                emit(it->second);
+        }
+    }
+}
+
+size_t LodHierarchy::size() const {
+    return m_size;
+}
+
+void LodHierarchy::clear() {
+    for (auto& level : m_levels)
+        level.clear();
+    m_entries.clear();
+    m_size = 0;
+}
@@ -0,0 +1,73 @@
+#pragma once
+#ifndef LOD_HIERARCHY_H
+#define LOD_HIERARCHY_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <entt/entt.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+// LodHierarchy aggregates point entities into a pyramid of hashed grids for
+// drawing at extreme zoom-out. Level 0 cells are baseCellSize wide and every
+// level doubles the cell size; each cell keeps the count, centroid and mean
+// colour of the entities inside it. Insert, move and remove touch one cell per
+// level, so the hierarchy is kept up to date instead of being rebuilt.
+class LodHierarchy {
+public:
+    // One aggregated cell as returned by query().
+    struct Cluster {
+        sf::Vector2f center;
+        uint32_t count = 0;
+        sf::Color color;
+    };
+
+    explicit LodHierarchy(float baseCellSize = 512.f, size_t levels = 12);
+
+    // Add an entity, or move it if it is already present.
+    void insert(entt::entity entity, const sf::Vector2f& position, sf::Color color);
+    void update(entt::entity entity, const sf::Vector2f& position);
+    void remove(entt::entity entity);
+
+    // Colour the entity was inserted with (for drawing it as a single point).
+    [[nodiscard]] sf::Color color(entt::entity entity) const;
+
+    // Finest level whose cells are at least cellSize wide (clamped to the top).
+    [[nodiscard]] size_t levelFor(float cellSize) const;
+    [[nodiscard]] float cellSize(size_t level) const;
+    [[nodiscard]] size_t levelCount() const;
+
+    // Append the non-empty clusters of level whose cells intersect area.
+    void query(size_t level, const sf::FloatRect& area, std::vector<Cluster>& out) const;
+
+    [[nodiscard]] size_t size() const;
+    void clear();
+
+private:
+    struct Entry {
+        entt::entity entity = entt::null;
+        sf::Vector2f position;
+        sf::Color color;
+    };
+
+    // Running sums; doubles so repeated add/remove of large coordinates cannot drift.
+    struct Cell {
+        double x = 0.0;
+        double y = 0.0;
+        uint32_t count = 0;
+        uint32_t r = 0, g = 0, b = 0;
+    };
+
+    [[nodiscard]] int32_t cellCoord(float value, size_t level) const;
+    [[nodiscard]] static uint64_t cellKey(int32_t x, int32_t y);
+    void add(const Entry& entry, int sign);
+
+    float m_baseCellSize;
+    std::vector<std::unordered_map<uint64_t, Cell>> m_levels;
+    std::vector<Entry> m_entries; // Indexed by entity index.
+    size_t m_size = 0;
+};
+
+#endif // LOD_HIERARCHY_H
@@ -0,0 +1,103 @@
+#include <algorithm>
+// Eigen's fast vector sqrt is an approximation; the exact one rounds the same
+// way as std::sqrt, which the scalar kernel relies on. Every file that
+// includes Eigen must agree on this setting.
+#define EIGEN_FAST_MATH 0
+#include <Eigen/Core>
+#include "Motion.h"
+
+// The packet and scalar kernels must round every multiply and add on its own
+// to agree bit for bit, so keep the compiler from fusing them into FMAs.
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#elif defined(_MSC_VER)
+#pragma fp_contract(off)
+#endif
+
+// Components are gathered field by field with a fixed float stride.
+static_assert(sizeof(Transform2D) == 4 * sizeof(float), "Transform2D must be four packed floats");
+static_assert(sizeof(Velocity) == 2 * sizeof(float), "Velocity must be two packed floats");
+static_assert(sizeof(Movement) == 3 * sizeof(float), "Movement must be three packed floats");
+
+namespace {
+
+using Eigen::internal::packet_traits;
+
+// Widest float packet enabled for this build (SSE, AVX...; plain float when
+// vectorization is off).
+using FloatPacket = packet_traits<float>::type;
+constexpr size_t packetSize = static_cast<size_t>(packet_traits<float>::size);
+
+// One integration step for the Packet-width run of entities starting at the
+// given pointers. Instantiated with float this is the scalar fallback; it runs
+// the exact same operations in the same order, only one lane wide.
+template <typename Packet>
+void step(Transform2D* transforms, Velocity* velocities, const Movement* movements, float dt) {
+    using namespace Eigen::internal;
+    const Packet pdt = pset1<Packet>(dt);
+
+    Packet vx = pgather<float, Packet>(&velocities->value.x, 2);
+    Packet vy = pgather<float, Packet>(&velocities->value.y, 2);
+    const Packet ax = pgather<float, Packet>(&movements->acceleration.x, 3);
+    const Packet ay = pgather<float, Packet>(&movements->acceleration.y, 3);
+    const Packet maxSpeed = pgather<float, Packet>(&movements->maxSpeed, 3);
+    vx = padd(vx, pmul(ax, pdt));
+    vy = padd(vy, pmul(ay, pdt));
+
+    // Clamp by selecting a scale factor per lane instead of branching; the
+    // square root runs for every lane at once.
+    const Packet speedSq = padd(pmul(vx, vx), pmul(vy, vy));
+    const Packet limited = pand(pcmp_lt(pzero(maxSpeed), maxSpeed), pcmp_lt(pmul(maxSpeed, maxSpeed), speedSq));
+    const Packet factor = pselect(limited, pdiv(maxSpeed, psqrt(speedSq)), pset1<Packet>(1.f));
+    vx = pmul(vx, factor);
+    vy = pmul(vy, factor);
+    pscatter<float, Packet>(&velocities->value.x, vx, 2);
+    pscatter<float, Packet>(&velocities->value.y, vy, 2);
+
+    const Packet px = pgather<float, Packet>(&transforms->position.x, 4);
+    const Packet py = pgather<float, Packet>(&transforms->position.y, 4);
+    pscatter<float, Packet>(&transforms->prevPosition.x, px, 4);
+    pscatter<float, Packet>(&transforms->prevPosition.y, py, 4);
+    pscatter<float, Packet>(&transforms->position.x, padd(px, pmul(vx, pdt)), 4);
+    pscatter<float, Packet>(&transforms->position.y, padd(py, pmul(vy, pdt)), 4);
+}
+
+} // namespace
+
+Motion::Group Motion::group(entt::registry& registry) {
+    return registry.group<Transform2D, Velocity, Movement>();
+}
+
+void Motion::integrate(entt::registry& registry, float dt) {
+    const size_t count = group(registry).size();
+    auto& transforms = registry.storage<Transform2D>();
+    auto& velocities = registry.storage<Velocity>();
+    const auto& movements = registry.storage<Movement>();
+
+    // Owned components occupy the first count slots of each storage; storages
+    // are paged, so walk them a page at a time.
+    constexpr size_t page = entt::component_traits<Transform2D>::page_size;
+    static_assert(entt::component_traits<Velocity>::page_size == page &&
+        entt::component_traits<Movement>::page_size == page, "motion storages must share a page size");
+    for (size_t first = 0; first < count; first += page) {
+        const size_t index = first / page;
+        integrate(transforms.raw()[index], velocities.raw()[index], movements.raw()[index],
+            std::min(page, count - first), dt);
+    }
+}
+
+void Motion::integrate(Transform2D* transforms, Velocity* velocities, const Movement* movements,
+    size_t count, float dt) {
+    size_t i = 0;
+    for (; i + packetSize <= count; i += packetSize)
+        step<FloatPacket>(transforms + i, velocities + i, movements + i, dt);
+    integrateScalar(transforms + i, velocities + i, movements + i, count - i, dt);
+}
+
+void Motion::integrateScalar(Transform2D* transforms, Velocity* velocities, const Movement* movements,
+    size_t count, float dt) {
+    for (size_t i = 0; i < count; ++i)
+        step<float>(transforms + i, velocities + i, movements + i, dt);
+}
@@ -0,0 +1,37 @@
+#pragma once
+#ifndef MOTION_H
+#define MOTION_H
+
+#include <cstddef>
+#include <entt/entt.hpp>
+#include "Components.hpp"
+
+// Motion integrates moving entities: the owning group of Transform2D,
+// Velocity and Movement keeps those components packed at the front of their
+// storages in the same order, so a tick is a linear pass over plain arrays
+// (one pass per storage page) with no entity lookups. Runs of entities are
+// stepped with Eigen's packet math at the widest SIMD width the build enables
+// (SSE, AVX...), and the remainder with a scalar version of the same kernel
+// whose results are bit-identical.
+class Motion {
+public:
+    using Group = decltype(std::declval<entt::registry&>().group<Transform2D, Velocity, Movement>());
+
+    // Create (or fetch) the owning group. Call before other groups or views
+    // sort these storages; creating it early avoids re-packing existing entities.
+    static Group group(entt::registry& registry);
+
+    // Semi-implicit Euler step of dt seconds for every entity in the group:
+    // velocity += acceleration * dt, clamped to maxSpeed when it is set, then
+    // prevPosition = position and position += velocity * dt.
+    static void integrate(entt::registry& registry, float dt);
+
+    // The same step over count entities stored in parallel arrays.
+    static void integrate(Transform2D* transforms, Velocity* velocities, const Movement* movements,
+        size_t count, float dt);
+    // One entity at a time, with no SIMD; gives the same bits as integrate().
+    static void integrateScalar(Transform2D* transforms, Velocity* velocities, const Movement* movements,
+        size_t count, float dt);
+};
+
+#endif // MOTION_H
@@ -0,0 +1,441 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+// Must match the other translation units that include Eigen (see Motion.cpp).
+#define EIGEN_FAST_MATH 0
+#include <Eigen/Core>
+#include "Narrowphase.h"
+
+namespace {
+
+using Eigen::internal::packet_traits;
+using FloatPacket = packet_traits<float>::type;
+constexpr size_t packetSize = static_cast<size_t>(packet_traits<float>::size);
+
+size_t roundUpToPacket(size_t count) {
+    return (count + packetSize - 1) / packetSize * packetSize;
+}
+
+// Zero-fill lanes for count pairs; padding lanes stay zero and are never read back.
+void resizeLanes(std::initializer_list<std::vector<float>*> lanes, size_t count) {
+    const size_t padded = roundUpToPacket(count);
+    for (std::vector<float>* values : lanes)
+        values->assign(padded, 0.f);
+}
+
+float dot(const Vector2f& a, const Vector2f& b) {
+    return a.x * b.x + a.y * b.y;
+}
+
+size_t entityIndex(entt::entity entity) {
+    return static_cast<size_t>(entt::to_entity(entity));
+}
+
+} // namespace
+
+Narrowphase::Shape Narrowphase::shapeOf(const entt::registry& registry, entt::entity entity) {
+    if (!registry.all_of<Transform2D>(entity))
+        return Shape::None;
+    if (const auto* complex = registry.try_get<ComplexCollider>(entity); complex && complex->points.size() >= 3)
+        return Shape::Polygon;
+    if (registry.all_of<CircleCollider>(entity))
+        return Shape::Circle;
+    if (registry.all_of<BoxCollider>(entity))
+        return Shape::Box;
+    return Shape::None;
+}
+
+void Narrowphase::run(const std::vector<Broadphase::Pair>& pairs, const entt::registry& registry, const Vector2f& maxDist) {
+    // Sort pairs into one list per shape combination.
+    m_boxPairs.clear();
+    m_circlePairs.clear();
+    m_circleBoxPairs.clear();
+    m_circleBoxSwapped.clear();
+    m_polygonPairs.clear();
+    for (const Broadphase::Pair& pair : pairs) {
+        const Shape a = shapeOf(registry, pair.a);
+        const Shape b = shapeOf(registry, pair.b);
+        if (a == Shape::None || b == Shape::None)
+            continue;
+        if (a == Shape::Polygon || b == Shape::Polygon) {
+            m_polygonPairs.push_back(pair);
+        }
+        else if (a == Shape::Box && b == Shape::Box) {
+            m_boxPairs.push_back(pair);
+        }
+        else if (a == Shape::Circle && b == Shape::Circle) {
+            m_circlePairs.push_back(pair);
+        }
+        else {
+            const bool swapped = a == Shape::Box;
+            m_circleBoxPairs.push_back(swapped ? Broadphase::Pair{ pair.b, pair.a } : pair);
+            m_circleBoxSwapped.push_back(swapped);
+        }
+    }
+
+    m_contacts.clear();
+    boxes(registry, maxDist);
+    circles(registry);
+    circleBoxes(registry);
+    polygons(registry);
+}
+
+void Narrowphase::boxes(const entt::registry& registry, const Vector2f& maxDist) {
+    // Gather: the only registry lookups, one pass over the pairs.
+    const size_t count = m_boxPairs.size();
+    resizeLanes({ &m_boxA.x, &m_boxA.y, &m_boxA.prevX, &m_boxA.prevY, &m_boxA.halfX, &m_boxA.halfY,
+        &m_boxB.x, &m_boxB.y, &m_boxB.prevX, &m_boxB.prevY, &m_boxB.halfX, &m_boxB.halfY,
+        &m_overlapX, &m_overlapY, &m_prevOverlapX, &m_prevOverlapY, &m_direction }, count);
+    auto view = registry.view<const Transform2D, const BoxCollider>();
+    auto gather = [&](BoxLanes& side, size_t i, entt::entity entity) {
+        const auto& [transform, box] = view.get(entity);
+        side.x[i] = transform.position.x + box.offset.x;
+        side.y[i] = transform.position.y + box.offset.y;
+        side.prevX[i] = transform.prevPosition.x + box.offset.x;
+        side.prevY[i] = transform.prevPosition.y + box.offset.y;
+        side.halfX[i] = box.size.x / 2.f;
+        side.halfY[i] = box.size.y / 2.f;
+    };
+    for (size_t i = 0; i < count; ++i) {
+        gather(m_boxA, i, m_boxPairs[i].a);
+        gather(m_boxB, i, m_boxPairs[i].b);
+    }
+
+    // Test a packet of pairs at a time.
+    using namespace Eigen::internal;
+    const FloatPacket zero = pset1<FloatPacket>(0.f);
+    const FloatPacket minOverlapX = pset1<FloatPacket>(-maxDist.x);
+    const FloatPacket minOverlapY = pset1<FloatPacket>(-maxDist.y);
+    const auto directionCode = [](ODirection direction) { return pset1<FloatPacket>(static_cast<float>(direction)); };
+    for (size_t i = 0; i < m_overlapX.size(); i += packetSize) {
+        const FloatPacket halfX = padd(ploadu<FloatPacket>(&m_boxA.halfX[i]), ploadu<FloatPacket>(&m_boxB.halfX[i]));
+        const FloatPacket halfY = padd(ploadu<FloatPacket>(&m_boxA.halfY[i]), ploadu<FloatPacket>(&m_boxB.halfY[i]));
+        // b - a, signed for the direction, absolute for the overlaps.
+        const FloatPacket dx = psub(ploadu<FloatPacket>(&m_boxB.x[i]), ploadu<FloatPacket>(&m_boxA.x[i]));
+        const FloatPacket dy = psub(ploadu<FloatPacket>(&m_boxB.y[i]), ploadu<FloatPacket>(&m_boxA.y[i]));
+        const FloatPacket prevDx = psub(ploadu<FloatPacket>(&m_boxB.prevX[i]), ploadu<FloatPacket>(&m_boxA.prevX[i]));
+        const FloatPacket prevDy = psub(ploadu<FloatPacket>(&m_boxB.prevY[i]), ploadu<FloatPacket>(&m_boxA.prevY[i]));
+        const FloatPacket overlapX = psub(halfX, pabs(dx));
+        const FloatPacket overlapY = psub(halfY, pabs(dy));
+        const FloatPacket prevOverlapX = psub(halfX, pabs(prevDx));
+        const FloatPacket prevOverlapY = psub(halfY, pabs(prevDy));
+
+        // Same rules as AisNearB: a side is hit when the boxes overlap now but
+        // did not overlap on that axis last tick; horizontal hits win.
+        const FloatPacket overlapping = pand(pcmp_lt(zero, overlapX), pcmp_lt(zero, overlapY));
+        const FloatPacket vertical = pand(overlapping, pand(pcmp_lt(minOverlapY, overlapY), pcmp_le(prevOverlapY, zero)));
+        const FloatPacket horizontal = pand(overlapping, pand(pcmp_lt(minOverlapX, overlapX), pcmp_le(prevOverlapX, zero)));
+        FloatPacket direction = directionCode(ODirection::NONE);
+        direction = pselect(pand(vertical, pcmp_lt(zero, dy)), directionCode(ODirection::UP), direction);
+        direction = pselect(pand(vertical, pcmp_lt(dy, zero)), directionCode(ODirection::DOWN), direction);
+        direction = pselect(pand(horizontal, pcmp_lt(zero, dx)), directionCode(ODirection::LEFT), direction);
+        direction = pselect(pand(horizontal, pcmp_lt(dx, zero)), directionCode(ODirection::RIGHT), direction);
+
+        pstoreu(&m_overlapX[i], overlapX);
+        pstoreu(&m_overlapY[i], overlapY);
+        pstoreu(&m_prevOverlapX[i], prevOverlapX);
+        pstoreu(&m_prevOverlapY[i], prevOverlapY);
+        pstoreu(&m_direction[i], direction);
+    }
+
+    m_boxOverlaps.resize(count);
+    m_boxPreviousOverlaps.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        m_boxOverlaps[i] = { static_cast<ODirection>(static_cast<int>(m_direction[i])), { m_overlapX[i], m_overlapY[i] } };
+        m_boxPreviousOverlaps[i] = { m_prevOverlapX[i], m_prevOverlapY[i] };
+    }
+}
+
+void Narrowphase::circles(const entt::registry& registry) {
+    const size_t count = m_circlePairs.size();
+    resizeLanes({ &m_circleA.x, &m_circleA.y, &m_circleA.radius, &m_circleB.x, &m_circleB.y, &m_circleB.radius,
+        &m_hit, &m_normalX, &m_normalY, &m_depth }, count);
+    auto view = registry.view<const Transform2D, const CircleCollider>();
+    auto gather = [&](CircleLanes& side, size_t i, entt::entity entity) {
+        const auto& [transform, circle] = view.get(entity);
+        side.x[i] = transform.position.x + circle.offset.x;
+        side.y[i] = transform.position.y + circle.offset.y;
+        side.radius[i] = circle.radius;
+    };
+    for (size_t i = 0; i < count; ++i) {
+        gather(m_circleA, i, m_circlePairs[i].a);
+        gather(m_circleB, i, m_circlePairs[i].b);
+    }
+
+    using namespace Eigen::internal;
+    const FloatPacket zero = pset1<FloatPacket>(0.f);
+    const FloatPacket one = pset1<FloatPacket>(1.f);
+    for (size_t i = 0; i < m_hit.size(); i += packetSize) {
+        const FloatPacket dx = psub(ploadu<FloatPacket>(&m_circleB.x[i]), ploadu<FloatPacket>(&m_circleA.x[i]));
+        const FloatPacket dy = psub(ploadu<FloatPacket>(&m_circleB.y[i]), ploadu<FloatPacket>(&m_circleA.y[i]));
+        const FloatPacket radii = padd(ploadu<FloatPacket>(&m_circleA.radius[i]), ploadu<FloatPacket>(&m_circleB.radius[i]));
+        const FloatPacket distSq = padd(pmul(dx, dx), pmul(dy, dy));
+        const FloatPacket hit = pcmp_lt(distSq, pmul(radii, radii));
+
+        // Concentric circles get an arbitrary +x normal.
+        const FloatPacket dist = psqrt(distSq);
+        const FloatPacket apart = pcmp_lt(zero, dist);
+        const FloatPacket inverse = pdiv(one, dist);
+        pstoreu(&m_hit[i], pselect(hit, one, zero));
+        pstoreu(&m_normalX[i], pselect(apart, pmul(dx, inverse), one));
+        pstoreu(&m_normalY[i], pselect(apart, pmul(dy, inverse), zero));
+        pstoreu(&m_depth[i], psub(radii, dist));
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (m_hit[i] != 0.f)
+            m_contacts.push_back({ m_circlePairs[i].a, m_circlePairs[i].b, { m_normalX[i], m_normalY[i] }, m_depth[i] });
+    }
+}
+
+void Narrowphase::circleBoxes(const entt::registry& registry) {
+    // Circles in the a lanes, boxes in the b lanes.
+    const size_t count = m_circleBoxPairs.size();
+    resizeLanes({ &m_circleA.x, &m_circleA.y, &m_circleA.radius, &m_boxB.x, &m_boxB.y, &m_boxB.halfX, &m_boxB.halfY,
+        &m_hit, &m_normalX, &m_normalY, &m_depth }, count);
+    auto circles = registry.view<const Transform2D, const CircleCollider>();
+    auto boxes = registry.view<const Transform2D, const BoxCollider>();
+    for (size_t i = 0; i < count; ++i) {
+        const auto& [circleTransform, circle] = circles.get(m_circleBoxPairs[i].a);
+        m_circleA.x[i] = circleTransform.position.x + circle.offset.x;
+        m_circleA.y[i] = circleTransform.position.y + circle.offset.y;
+        m_circleA.radius[i] = circle.radius;
+        const auto& [boxTransform, box] = boxes.get(m_circleBoxPairs[i].b);
+        m_boxB.x[i] = boxTransform.position.x + box.offset.x;
+        m_boxB.y[i] = boxTransform.position.y + box.offset.y;
+        m_boxB.halfX[i] = box.size.x / 2.f;
+        m_boxB.halfY[i] = box.size.y / 2.f;
+    }
+
+    using namespace Eigen::internal;
+    const FloatPacket zero = pset1<FloatPacket>(0.f);
+    const FloatPacket one = pset1<FloatPacket>(1.f);
+    const FloatPacket minusOne = pset1<FloatPacket>(-1.f);
+    for (size_t i = 0; i < m_hit.size(); i += packetSize) {
+        const FloatPacket radius = ploadu<FloatPacket>(&m_circleA.radius[i]);
+        const FloatPacket halfX = ploadu<FloatPacket>(&m_boxB.halfX[i]);
+        const FloatPacket halfY = ploadu<FloatPacket>(&m_boxB.halfY[i]);
+        // Circle centre relative to the box centre, and the closest point of the box to it.
+        const FloatPacket localX = psub(ploadu<FloatPacket>(&m_circleA.x[i]), ploadu<FloatPacket>(&m_boxB.x[i]));
+        const FloatPacket localY = psub(ploadu<FloatPacket>(&m_circleA.y[i]), ploadu<FloatPacket>(&m_boxB.y[i]));
+        const FloatPacket gapX = psub(localX, pmin(pmax(localX, pnegate(halfX)), halfX));
+        const FloatPacket gapY = psub(localY, pmin(pmax(localY, pnegate(halfY)), halfY));
+        const FloatPacket distSq = padd(pmul(gapX, gapX), pmul(gapY, gapY));
+
+        // Outside the box: push out along the gap. Centre inside: push out
+        // through the nearest face.
+        const FloatPacket inside = pcmp_eq(distSq, zero);
+        const FloatPacket hit = por(inside, pcmp_lt(distSq, pmul(radius, radius)));
+        const FloatPacket dist = psqrt(distSq);
+        const FloatPacket inverse = pdiv(one, dist);
+        const FloatPacket penetrationX = psub(halfX, pabs(localX));
+        const FloatPacket penetrationY = psub(halfY, pabs(localY));
+        const FloatPacket alongX = pcmp_lt(penetrationX, penetrationY);
+        const FloatPacket signX = pselect(pcmp_lt(localX, zero), minusOne, one);
+        const FloatPacket signY = pselect(pcmp_lt(localY, zero), minusOne, one);
+        const FloatPacket faceX = pselect(alongX, signX, zero);
+        const FloatPacket faceY = pselect(alongX, zero, signY);
+        const FloatPacket faceDepth = padd(radius, pmin(penetrationX, penetrationY));
+
+        // The normal points from the box to the circle.
+        pstoreu(&m_hit[i], pselect(hit, one, zero));
+        pstoreu(&m_normalX[i], pselect(inside, faceX, pmul(gapX, inverse)));
+        pstoreu(&m_normalY[i], pselect(inside, faceY, pmul(gapY, inverse)));
+        pstoreu(&m_depth[i], pselect(inside, faceDepth, psub(radius, dist)));
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (m_hit[i] == 0.f)
+            continue;
+        const Broadphase::Pair& pair = m_circleBoxPairs[i];
+        const Vector2f boxToCircle(m_normalX[i], m_normalY[i]);
+        // Report the pair in its original order, normal from a to b.
+        if (m_circleBoxSwapped[i])
+            m_contacts.push_back({ pair.b, pair.a, boxToCircle, m_depth[i] });
+        else
+            m_contacts.push_back({ pair.a, pair.b, -boxToCircle, m_depth[i] });
+    }
+}
+
+const Narrowphase::Polygon& Narrowphase::polygon(const entt::registry& registry, entt::entity entity) {
+    Polygon& polygon = m_polygons[entityIndex(entity)];
+    if (polygon.stamp == m_stamp)
+        return polygon;
+    polygon.stamp = m_stamp;
+
+    // Local points -> world: scale, rotate, then translate.
+    const auto& transform = registry.get<Transform2D>(entity);
+    const auto& complex = registry.get<ComplexCollider>(entity);
+    const auto* orientation = registry.try_get<Orientation>(entity);
+    const float radians = orientation ? orientation->rotation * 3.14159265f / 180.f : 0.f;
+    const Vector2f scale = orientation ? orientation->scale : Vector2f(1.f, 1.f);
+    const float cosine = std::cos(radians);
+    const float sine = std::sin(radians);
+    polygon.points.clear();
+    polygon.center = { 0.f, 0.f };
+    for (const Vector2f& point : complex.points) {
+        const Vector2f scaled(point.x * scale.x, point.y * scale.y);
+        polygon.points.emplace_back(transform.position.x + scaled.x * cosine - scaled.y * sine,
+            transform.position.y + scaled.x * sine + scaled.y * cosine);
+        polygon.center += polygon.points.back();
+    }
+    polygon.center /= static_cast<float>(polygon.points.size());
+
+    float radiusSq = 0.f;
+    polygon.axes.clear();
+    for (size_t i = 0; i < polygon.points.size(); ++i) {
+        const Vector2f& point = polygon.points[i];
+        const Vector2f fromCenter = point - polygon.center;
+        radiusSq = std::max(radiusSq, dot(fromCenter, fromCenter));
+        const Vector2f edge = polygon.points[(i + 1) % polygon.points.size()] - point;
+        const float length = std::sqrt(dot(edge, edge));
+        if (length > 0.f)
+            polygon.axes.emplace_back(edge.y / length, -edge.x / length);
+    }
+    polygon.radius = std::sqrt(radiusSq);
+    return polygon;
+}
+
+const Narrowphase::Polygon& Narrowphase::boxPolygon(const entt::registry& registry, entt::entity entity) {
+    Polygon& polygon = m_boxPolygons[entityIndex(entity)];
+    if (polygon.stamp == m_stamp)
+        return polygon;
+    polygon.stamp = m_stamp;
+
+    const auto& transform = registry.get<Transform2D>(entity);
+    const auto& box = registry.get<BoxCollider>(entity);
+    const Vector2f half = box.size / 2.f;
+    polygon.center = transform.position + box.offset;
+    polygon.points = { polygon.center - half, { polygon.center.x + half.x, polygon.center.y - half.y },
+        polygon.center + half, { polygon.center.x - half.x, polygon.center.y + half.y } };
+    polygon.axes = { { 1.f, 0.f }, { 0.f, 1.f } };
+    polygon.radius = std::sqrt(dot(half, half));
+    return polygon;
+}
+
+Narrowphase::ShapeRef Narrowphase::shapeRef(const entt::registry& registry, entt::entity entity, Shape shape) {
+    if (shape == Shape::Circle) {
+        const auto& transform = registry.get<Transform2D>(entity);
+        const auto& circle = registry.get<CircleCollider>(entity);
+        return { nullptr, transform.position + circle.offset, circle.radius };
+    }
+    const Polygon& polygon = shape == Shape::Polygon ? this->polygon(registry, entity) : boxPolygon(registry, entity);
+    return { &polygon, polygon.center, polygon.radius };
+}
+
+bool Narrowphase::separatingAxisTest(const ShapeRef& a, const ShapeRef& b, Contact& contact) {
+    // Bounding circles first; most candidate pairs stop here.
+    const Vector2f between = b.center - a.center;
+    const float radii = a.radius + b.radius;
+    if (dot(between, between) >= radii * radii)
+        return false;
+
+    float bestDepth = std::numeric_limits<float>::max();
+    Vector2f bestAxis(1.f, 0.f);
+    auto project = [](const ShapeRef& shape, const Vector2f& axis, float& min, float& max) {
+        if (!shape.polygon) {
+            const float center = dot(shape.center, axis);
+            min = center - shape.radius;
+            max = center + shape.radius;
+            return;
+        }
+        min = max = dot(shape.polygon->points.front(), axis);
+        for (const Vector2f& point : shape.polygon->points) {
+            const float projected = dot(point, axis);
+            min = std::min(min, projected);
+            max = std::max(max, projected);
+        }
+    };
+    auto test = [&](const Vector2f& axis) {
+        float minA, maxA, minB, maxB;
+        project(a, axis, minA, maxA);
+        project(b, axis, minB, maxB);
+        // Distance to push either way until the projections separate.
+        const float depth = std::min(maxA - minB, maxB - minA);
+        if (depth <= 0.f)
+            return false;
+        if (depth < bestDepth) {
+            bestDepth = depth;
+            bestAxis = axis;
+        }
+        return true;
+    };
+
+    for (const ShapeRef* shape : { &a, &b }) {
+        if (!shape->polygon)
+            continue;
+        for (const Vector2f& axis : shape->polygon->axes) {
+            if (!test(axis))
+                return false;
+        }
+    }
+    // A circle can also be separated along the line to the polygon's nearest vertex.
+    for (const auto& [circle, other] : { std::pair{ &a, &b }, std::pair{ &b, &a } }) {
+        if (circle->polygon || !other->polygon)
+            continue;
+        Vector2f nearest = other->polygon->points.front();
+        for (const Vector2f& point : other->polygon->points) {
+            if (dot(point - circle->center, point - circle->center) < dot(nearest - circle->center, nearest - circle->center))
+                nearest = point;
+        }
+        const Vector2f toVertex = nearest - circle->center;
+        const float length = std::sqrt(dot(toVertex, toVertex));
+        if (length > 0.f && !test(toVertex / length))
+            return false;
+    }
+
+    if (dot(between, bestAxis) < 0.f)
+        bestAxis = -bestAxis;
+    contact.normal = bestAxis;
+    contact.depth = bestDepth;
+    return true;
+}
+
+void Narrowphase::polygons(const entt::registry& registry) {
+    // Polygons are rebuilt at most once per run, on first use. The caches are
+    // sized up front so references to them stay valid during the loop.
+    m_stamp++;
+    size_t entityCount = 0;
+    for (const Broadphase::Pair& pair : m_polygonPairs)
+        entityCount = std::max({ entityCount, entityIndex(pair.a) + 1, entityIndex(pair.b) + 1 });
+    if (entityCount > m_polygons.size()) {
+        m_polygons.resize(entityCount);
+        m_boxPolygons.resize(entityCount);
+    }
+    for (const Broadphase::Pair& pair : m_polygonPairs) {
+        const ShapeRef a = shapeRef(registry, pair.a, shapeOf(registry, pair.a));
+        const ShapeRef b = shapeRef(registry, pair.b, shapeOf(registry, pair.b));
+        Contact contact{ pair.a, pair.b };
+        if (separatingAxisTest(a, b, contact))
+            m_contacts.push_back(contact);
+    }
+}
+
+const std::vector<Broadphase::Pair>& Narrowphase::boxPairs() const {
+    return m_boxPairs;
+}
+
+const std::vector<RectOverlap>& Narrowphase::boxOverlaps() const {
+    return m_boxOverlaps;
+}
+
+const std::vector<Vector2f>& Narrowphase::boxPreviousOverlaps() const {
+    return m_boxPreviousOverlaps;
+}
+
+const std::vector<Narrowphase::Contact>& Narrowphase::contacts() const {
+    return m_contacts;
+}
+
+void Narrowphase::clear() {
+    m_boxPairs.clear();
+    m_circlePairs.clear();
+    m_circleBoxPairs.clear();
+    m_circleBoxSwapped.clear();
+    m_polygonPairs.clear();
+    m_polygons.clear();
+    m_boxPolygons.clear();
+    m_boxOverlaps.clear();
+    m_boxPreviousOverlaps.clear();
+    m_contacts.clear();
+}
@@ -0,0 +1,123 @@
+#pragma once
+#ifndef NARROWPHASE_H
+#define NARROWPHASE_H
+
+#include <cstdint>
+#include <vector>
+#include <entt/entt.hpp>
+#include "Broadphase.h"
+#include "Components.hpp"
+#include "Physics.h"
+
+// Narrowphase runs the exact collision tests on the candidate pairs found by
+// Broadphase, in batches.
+//
+// Each entity is tested as one shape: its ComplexCollider (a convex polygon)
+// if it has one, else its CircleCollider, else its BoxCollider. Pairs are
+// first sorted into one list per shape combination, so each list runs a
+// single kernel with no per-pair dispatch:
+//  - box/box is the batched form of Physics::AisNearB (overlaps and
+//    ODirection, see boxOverlaps());
+//  - circle/circle and circle/box gather centres and extents into
+//    structure-of-arrays buffers (the only registry access) and are computed
+//    with Eigen packet math, a SIMD register of pairs at a time;
+//  - pairs with a polygon use SAT. Each polygon's world-space points, edge
+//    axes and bounding circle are computed once per run and shared by all of
+//    its pairs; the bounding circles reject most pairs before any axis test.
+// Unlike Physics, box centres include BoxCollider::offset.
+class Narrowphase {
+public:
+    enum class Shape : uint8_t {
+        None,
+        Box,
+        Circle,
+        Polygon
+    };
+
+    // A penetrating circle or polygon pair.
+    struct Contact {
+        entt::entity a = entt::null;
+        entt::entity b = entt::null;
+        Vector2f normal{ 0.f, 0.f }; // Unit vector pointing from a towards b.
+        float depth = 0.f;           // Penetration along the normal.
+    };
+
+    // Test every pair. maxDist is the tolerance used for box pairs, as in
+    // Physics::AisNearB.
+    void run(const std::vector<Broadphase::Pair>& pairs, const entt::registry& registry, const Vector2f& maxDist);
+
+    [[nodiscard]] static Shape shapeOf(const entt::registry& registry, entt::entity entity);
+
+    // Box results, in the order of the box pairs they belong to (every box
+    // pair is reported, overlapping or not).
+    [[nodiscard]] const std::vector<Broadphase::Pair>& boxPairs() const;
+    [[nodiscard]] const std::vector<RectOverlap>& boxOverlaps() const;
+    [[nodiscard]] const std::vector<Vector2f>& boxPreviousOverlaps() const;
+
+    // Penetrating pairs that involve a circle or a polygon.
+    [[nodiscard]] const std::vector<Contact>& contacts() const;
+
+    void clear();
+
+private:
+    // A box pair's previous positions are only used by the box kernel.
+    struct BoxLanes {
+        std::vector<float> x, y, prevX, prevY, halfX, halfY;
+    };
+    struct CircleLanes {
+        std::vector<float> x, y, radius;
+    };
+    // World-space form of a polygon for the current run.
+    struct Polygon {
+        std::vector<Vector2f> points;
+        std::vector<Vector2f> axes; // Unit edge normals.
+        Vector2f center{ 0.f, 0.f };
+        float radius = 0.f;         // Bounding circle around center.
+        uint32_t stamp = 0;         // Run in which it was built.
+    };
+    // Shapes of a polygon pair, as polygons or circles.
+    struct ShapeRef {
+        const Polygon* polygon = nullptr;
+        Vector2f center{ 0.f, 0.f };
+        float radius = 0.f;
+    };
+
+    void boxes(const entt::registry& registry, const Vector2f& maxDist);
+    void circles(const entt::registry& registry);
+    void circleBoxes(const entt::registry& registry);
+    void polygons(const entt::registry& registry);
+
+    // Cached world-space polygon; the caches must already cover entity's index.
+    const Polygon& polygon(const entt::registry& registry, entt::entity entity);
+    // Polygon stand-in for a box (axis-aligned, no rotation).
+    const Polygon& boxPolygon(const entt::registry& registry, entt::entity entity);
+    ShapeRef shapeRef(const entt::registry& registry, entt::entity entity, Shape shape);
+    // SAT on two shapes (at least one a polygon); false if separated.
+    static bool separatingAxisTest(const ShapeRef& a, const ShapeRef& b, Contact& contact);
+
+    // Pairs of each shape combination; circle/box pairs hold the circle in a.
+    std::vector<Broadphase::Pair> m_boxPairs;
+    std::vector<Broadphase::Pair> m_circlePairs;
+    std::vector<Broadphase::Pair> m_circleBoxPairs;
+    std::vector<char> m_circleBoxSwapped; // The pair's circle was its b.
+    std::vector<Broadphase::Pair> m_polygonPairs;
+
+    // Structure-of-arrays inputs, padded to whole packets.
+    BoxLanes m_boxA;
+    BoxLanes m_boxB;
+    CircleLanes m_circleA;
+    CircleLanes m_circleB;
+    // Outputs per lane.
+    std::vector<float> m_overlapX, m_overlapY, m_prevOverlapX, m_prevOverlapY, m_direction;
+    std::vector<float> m_hit, m_normalX, m_normalY, m_depth;
+
+    std::vector<Polygon> m_polygons;    // Indexed by entity index.
+    std::vector<Polygon> m_boxPolygons; // Indexed by entity index.
+    uint32_t m_stamp = 0;
+
+    std::vector<RectOverlap> m_boxOverlaps;
+    std::vector<Vector2f> m_boxPreviousOverlaps;
+    std::vector<Contact> m_contacts;
+};
+
+#endif // NARROWPHASE_H
@@ -84,7 +84,7 @@ Intersect Physics::LineIntersect(const Vector2f& a, const Vector2f& b,
     float u = cross(cma, r) / rxs;
 
     if (t >= 0.f && t <= 1.f && u >= 0.f && u <= 1.f)
-        return { true, a + t * r };
+        return { true, a + t * r, t };
     else
         return { false, Vector2f(0.f, 0.f) };
 }
@@ -113,6 +113,40 @@ bool Physics::EntityIntersect(const Vector2f& a, const Vector2f& b,
     return false;
 }
 
+Intersect Physics::SweepBox(const Vector2f& a, const Vector2f& b, const Vector2f& center, const Vector2f& halfSize) {
+    if (std::abs(a.x - center.x) < halfSize.x && std::abs(a.y - center.y) < halfSize.y)
+        return { true, a, 0.f };
+
+    // The first of the four edges the segment crosses.
+    const Vector2f corners[4] = { { center.x - halfSize.x, center.y - halfSize.y }, { center.x + halfSize.x, center.y - halfSize.y },
+        { center.x + halfSize.x, center.y + halfSize.y }, { center.x - halfSize.x, center.y + halfSize.y } };
+    Intersect earliest;
+    for (int i = 0; i < 4; ++i) {
+        const Intersect hit = LineIntersect(a, b, corners[i], corners[(i + 1) % 4]);
+        if (hit.intersect && (!earliest.intersect || hit.time < earliest.time))
+            earliest = hit;
+    }
+    return earliest;
+}
+
+Intersect Physics::SweepCircle(const Vector2f& a, const Vector2f& b, const Vector2f& center, float radius) {
+    // Solve |a + t (b - a) - center| = radius for the smaller t in [0, 1].
+    const Vector2f d = b - a;
+    const Vector2f f = a - center;
+    const float c = dot(f, f) - radius * radius;
+    if (c < 0.f)
+        return { true, a, 0.f };
+    const float qa = dot(d, d);
+    const float qb = 2.f * dot(f, d);
+    const float discriminant = qb * qb - 4.f * qa * c;
+    if (qa == 0.f || discriminant < 0.f)
+        return {};
+    const float t = (-qb - std::sqrt(discriminant)) / (2.f * qa);
+    if (t < 0.f || t > 1.f)
+        return {};
+    return { true, a + t * d, t };
+}
+
 Vector2f Physics::getSpeedAB(const Vector2f& posA, const Vector2f& posB, float speed) {
     float theta = std::atan2(posB.y - posA.y, posB.x - posA.x);
     return Vector2f{ speed * std::cos(theta), speed * std::sin(theta) };
@@ -5,7 +5,7 @@
 #include <SFML/Graphics.hpp>
 #include "Components.hpp"
 // New Components are declared in Components.hpp, which should define:
-// struct Transform2D { sf::Vector2f position, prevPosition; float rotation; sf::Vector2f scale; };
+// struct Transform2D { sf::Vector2f position, prevPosition; };
 // struct BoxCollider { sf::Vector2f size; sf::Vector2f offset; };
 
 using sf::Vector2f;
@@ -13,6 +13,7 @@ using sf::Vector2f;
 struct Intersect {
     bool intersect = false;
     Vector2f position = { 0.f, 0.f };
+    float time = 0.f; // Fraction of the way from the first line's start to its end.
 };
 
 enum struct ODirection {
@@ -47,6 +48,11 @@ public:
     static bool EntityIntersect(const Vector2f& a, const Vector2f& b,
         entt::entity entity, entt::registry& registry);
 
+    // Earliest point where the segment a->b enters an axis-aligned box or a
+    // circle. A segment starting inside hits at time 0.
+    static Intersect SweepBox(const Vector2f& a, const Vector2f& b, const Vector2f& center, const Vector2f& halfSize);
+    static Intersect SweepCircle(const Vector2f& a, const Vector2f& b, const Vector2f& center, float radius);
+
     // Determine if entity A is near entity B (for collision resolution),
     // returning an overlap and a direction.
     static RectOverlap AisNearB(entt::entity a, entt::entity b, const Vector2f& maxDist, entt::registry& registry);
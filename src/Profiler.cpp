@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include "imgui.h"
+#include "nlohmann/json.hpp"
+#include "Profiler.h"
+#include "Logger.h"
+
+using json = nlohmann::json;
+
+// Number of frames kept for the frame-time histogram.
+static constexpr size_t frameHistory = 240;
+
+thread_local uint32_t ProfileZone::s_depth = 0;
+
+namespace {
+    thread_local void* t_buffer = nullptr;
+}
+
+Profiler::Profiler()
+    : m_epoch(std::chrono::steady_clock::now()) {
+}
+
+void Profiler::setEnabled(bool enabled) {
+    m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+int64_t Profiler::now() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_epoch).count();
+}
+
+Profiler::ThreadBuffer& Profiler::threadBuffer() {
+    if (!t_buffer) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->index = static_cast<uint32_t>(m_threads.size());
+        buffer->name = "Thread " + std::to_string(buffer->index);
+        t_buffer = buffer.get();
+        m_threads.push_back(std::move(buffer));
+    }
+    return *static_cast<ThreadBuffer*>(t_buffer);
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    buffer.name = name;
+}
+
+const char* Profiler::intern(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_names.insert(name).first->c_str();
+}
+
+void Profiler::record(const char* name, int64_t start, int64_t end, uint32_t depth) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.events.push_back({ name, start, end, buffer.index, depth });
+}
+
+void Profiler::beginFrame() {
+    if (!isEnabled())
+        return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_frameStart = now();
+}
+
+void Profiler::endFrame() {
+    if (!isEnabled())
+        return;
+
+    Frame frame;
+    frame.thread = threadBuffer().index;
+    frame.end = now();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    frame.start = m_frameStart;
+    for (auto& thread : m_threads) {
+        std::lock_guard<std::mutex> threadLock(thread->mutex);
+        frame.events.insert(frame.events.end(), thread->events.begin(), thread->events.end());
+        thread->events.clear();
+    }
+
+    m_frameTimes.push_back(static_cast<float>(frame.end - frame.start) / 1000.f);
+    if (m_frameTimes.size() > frameHistory)
+        m_frameTimes.pop_front();
+
+    if (m_captureRemaining > 0) {
+        m_capture.push_back(frame);
+        if (--m_captureRemaining == 0)
+            writeCapture();
+    }
+    if (!m_paused)
+        m_lastFrame = std::move(frame);
+}
+
+void Profiler::captureFrames(size_t frameCount, const std::string& path) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capture.clear();
+    m_captureRemaining = frameCount;
+    m_capturePath = path;
+}
+
+void Profiler::writeCapture() {
+    // Chrome trace_event format: complete ("X") events plus thread names.
+    json events = json::array();
+    for (const auto& thread : m_threads) {
+        events.push_back({ { "name", "thread_name" }, { "ph", "M" }, { "pid", 0 }, { "tid", thread->index },
+            { "args", { { "name", thread->name } } } });
+    }
+    for (const auto& frame : m_capture) {
+        events.push_back({ { "name", "Frame" }, { "ph", "X" }, { "pid", 0 }, { "tid", frame.thread },
+            { "ts", frame.start }, { "dur", frame.end - frame.start } });
+        for (const auto& event : frame.events) {
+            events.push_back({ { "name", event.name }, { "ph", "X" }, { "pid", 0 }, { "tid", event.thread },
+                { "ts", event.start }, { "dur", event.end - event.start } });
+        }
+    }
+
+    std::ofstream file(m_capturePath);
+    if (!file.is_open()) {
+        LOG("Could not write profiler capture: " + m_capturePath);
+        std::cerr << "Could not write profiler capture: " << m_capturePath << std::endl;
+    }
+    else {
+        file << json{ { "traceEvents", events }, { "displayTimeUnit", "ms" } };
+        LOG("Wrote " + std::to_string(m_capture.size()) + " frames to " + m_capturePath);
+    }
+    m_capture.clear();
+}
+
+void Profiler::drawImGui() {
+    if (!isEnabled())
+        return;
+
+    ImGui::Begin("Profiler");
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // --- Frame-time histogram ---
+    std::vector<float> times(m_frameTimes.begin(), m_frameTimes.end());
+    float worst = 0.f, total = 0.f;
+    for (float t : times) {
+        worst = std::max(worst, t);
+        total += t;
+    }
+    const float average = times.empty() ? 0.f : total / static_cast<float>(times.size());
+    ImGui::Text("Frame %.2f ms  avg %.2f ms  max %.2f ms",
+        times.empty() ? 0.f : times.back(), average, worst);
+    ImGui::PlotHistogram("##frameTimes", times.data(), static_cast<int>(times.size()), 0, nullptr,
+        0.f, std::max(worst, 1000.f / 30.f), ImVec2(-1.f, 80.f));
+
+    ImGui::Checkbox("Pause", &m_paused);
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(200.f);
+    ImGui::InputInt("Frames", &m_captureRequest);
+    ImGui::SameLine();
+    if (m_captureRemaining > 0) {
+        ImGui::Text("Capturing (%d left)", static_cast<int>(m_captureRemaining));
+    }
+    else if (ImGui::Button("Capture trace")) {
+        m_capture.clear();
+        m_captureRemaining = static_cast<size_t>(std::max(m_captureRequest, 1));
+        m_capturePath = "profile_trace.json";
+    }
+
+    // --- Flame graph of the last frame: one lane per thread, depth grows downward ---
+    const Frame& frame = m_lastFrame;
+    const float duration = static_cast<float>(std::max<int64_t>(frame.end - frame.start, 1));
+    const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+    const float width = ImGui::GetContentRegionAvail().x;
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const ImVec2 mouse = ImGui::GetIO().MousePos;
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+    float laneY = origin.y;
+    for (const auto& thread : m_threads) {
+        uint32_t maxDepth = 0;
+        bool any = false;
+        for (const auto& event : frame.events) {
+            if (event.thread == thread->index) {
+                maxDepth = std::max(maxDepth, event.depth);
+                any = true;
+            }
+        }
+        if (!any)
+            continue;
+
+        drawList->AddText(ImVec2(origin.x, laneY), IM_COL32(200, 200, 200, 255), thread->name.c_str());
+        laneY += rowHeight;
+        for (const auto& event : frame.events) {
+            if (event.thread != thread->index)
+                continue;
+            float x0 = origin.x + static_cast<float>(event.start - frame.start) / duration * width;
+            float x1 = origin.x + static_cast<float>(event.end - frame.start) / duration * width;
+            x0 = std::clamp(x0, origin.x, origin.x + width);
+            x1 = std::clamp(std::max(x1, x0 + 1.f), origin.x, origin.x + width);
+            const float y0 = laneY + static_cast<float>(event.depth) * rowHeight;
+            const ImVec2 min(x0, y0), max(x1, y0 + rowHeight - 1.f);
+
+            // Colour by zone name so a zone keeps its colour between frames.
+            const size_t hash = std::hash<std::string>{}(event.name);
+            const ImU32 color = IM_COL32(80 + hash % 150, 80 + (hash >> 8) % 150, 80 + (hash >> 16) % 150, 255);
+            drawList->AddRectFilled(min, max, color);
+            if (x1 - x0 > ImGui::CalcTextSize(event.name).x)
+                drawList->AddText(ImVec2(x0 + 2.f, y0), IM_COL32(0, 0, 0, 255), event.name);
+            if (mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y)
+                ImGui::SetTooltip("%s: %.3f ms", event.name, static_cast<float>(event.end - event.start) / 1000.f);
+        }
+        laneY += static_cast<float>(maxDepth + 1) * rowHeight;
+    }
+    ImGui::Dummy(ImVec2(width, std::max(laneY - origin.y, rowHeight)));
+
+    ImGui::End();
+}
@@ -0,0 +1,140 @@
+#pragma once
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// PROFILE_SCOPE(name) records the enclosing scope as a zone on the calling
+// thread. name must outlive the profiler (string literals, or Profiler::intern()).
+// When the profiler is disabled at runtime a zone costs one atomic load; define
+// ASTRAL_DISABLE_PROFILER to compile zones out entirely.
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+#ifndef ASTRAL_DISABLE_PROFILER
+#define PROFILE_SCOPE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name) do {} while (0)
+#endif
+
+// One completed zone. Times are microseconds since the profiler started.
+struct ProfileEvent {
+    const char* name = nullptr;
+    int64_t start = 0;
+    int64_t end = 0;
+    uint32_t thread = 0;
+    uint32_t depth = 0;
+};
+
+// Profiler collects zones from every thread into per-frame records, draws
+// them as a live flame graph and frame-time histogram in an ImGui window, and
+// can dump a number of frames to Chrome's trace_event JSON format.
+class Profiler {
+public:
+    static Profiler& getInstance() {
+        static Profiler instance;
+        return instance;
+    }
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    void setEnabled(bool enabled);
+    [[nodiscard]] bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    // Frame boundaries, called by GameEngine around each displayed frame.
+    void beginFrame();
+    void endFrame();
+
+    // Record the next frameCount frames and write them to path as a Chrome trace.
+    void captureFrames(size_t frameCount, const std::string& path);
+
+    // Return a pointer to a stable copy of name, for zones with runtime names.
+    const char* intern(const std::string& name);
+
+    // Label the calling thread in the flame graph and trace output.
+    void setThreadName(const std::string& name);
+
+    // Draw the profiler window (call between ImGui::SFML::Update and Render).
+    void drawImGui();
+
+    [[nodiscard]] int64_t now() const;
+
+    // Called by ProfileZone.
+    void record(const char* name, int64_t start, int64_t end, uint32_t depth);
+
+private:
+    struct ThreadBuffer {
+        std::mutex mutex;
+        std::vector<ProfileEvent> events;
+        uint32_t index = 0;
+        std::string name;
+    };
+
+    struct Frame {
+        int64_t start = 0;
+        int64_t end = 0;
+        uint32_t thread = 0; // Thread that ran the frame loop.
+        std::vector<ProfileEvent> events;
+    };
+
+    Profiler();
+    ThreadBuffer& threadBuffer();
+    void writeCapture();
+
+    std::atomic<bool> m_enabled{ false };
+    std::chrono::steady_clock::time_point m_epoch;
+
+    std::mutex m_mutex; // Guards the members below.
+    std::vector<std::unique_ptr<ThreadBuffer>> m_threads;
+    std::unordered_set<std::string> m_names;
+
+    int64_t m_frameStart = 0;
+    Frame m_lastFrame;
+    std::deque<float> m_frameTimes; // Milliseconds, most recent last.
+    bool m_paused = false;
+
+    std::vector<Frame> m_capture;
+    size_t m_captureRemaining = 0;
+    std::string m_capturePath;
+    int m_captureRequest = 120;
+};
+
+// RAII zone; see PROFILE_SCOPE.
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name) {
+        Profiler& profiler = Profiler::getInstance();
+        if (!profiler.isEnabled())
+            return;
+        m_name = name;
+        m_depth = s_depth++;
+        m_start = profiler.now();
+    }
+
+    ~ProfileZone() {
+        if (!m_name)
+            return;
+        --s_depth;
+        Profiler& profiler = Profiler::getInstance();
+        profiler.record(m_name, m_start, profiler.now(), m_depth);
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    static thread_local uint32_t s_depth;
+    const char* m_name = nullptr;
+    int64_t m_start = 0;
+    uint32_t m_depth = 0;
+};
+
+#endif // PROFILER_H
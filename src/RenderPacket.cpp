@@ -0,0 +1,194 @@
+#include <stdexcept>
+#include <SFML/Graphics/Sprite.hpp>
+#include "RenderPacket.h"
+#include "Logger.h"
+
+void RenderPacket::reset() {
+    m_commands.clear();
+    m_vertices.clear();
+    m_views.clear();
+    m_texts.clear();
+    m_buffers.clear();
+    m_caches.clear();
+}
+
+void RenderPacket::clear(sf::Color color) {
+    Command command;
+    command.type = CommandType::Clear;
+    command.color = color;
+    m_commands.push_back(command);
+}
+
+void RenderPacket::setView(const sf::View& view) {
+    m_view = view;
+    Command command;
+    command.type = CommandType::View;
+    command.index = m_views.size();
+    m_views.push_back(view);
+    m_commands.push_back(command);
+}
+
+const sf::View& RenderPacket::view() const {
+    return m_view;
+}
+
+bool RenderPacket::canMerge(const Command& command, sf::PrimitiveType type, const sf::RenderStates& states) {
+    // Only list primitives can be concatenated; strips and fans are connected.
+    const bool list = type == sf::PrimitiveType::Triangles || type == sf::PrimitiveType::Lines ||
+        type == sf::PrimitiveType::Points;
+    return list && command.type == CommandType::Vertices && command.primitive == type &&
+        command.states.texture == states.texture && command.states.shader == states.shader &&
+        command.states.blendMode == states.blendMode && command.states.transform == states.transform &&
+        command.states.coordinateType == states.coordinateType && command.states.stencilMode == states.stencilMode;
+}
+
+void RenderPacket::draw(const sf::Vertex* vertices, size_t count, sf::PrimitiveType type, const sf::RenderStates& states) {
+    if (count == 0)
+        return;
+
+    if (m_commands.empty() || !canMerge(m_commands.back(), type, states)) {
+        Command command;
+        command.type = CommandType::Vertices;
+        command.index = m_vertices.size();
+        command.primitive = type;
+        command.states = states;
+        m_commands.push_back(command);
+    }
+    m_commands.back().count += count;
+    m_vertices.insert(m_vertices.end(), vertices, vertices + count);
+}
+
+void RenderPacket::draw(const sf::VertexArray& vertices, const sf::RenderStates& states) {
+    if (vertices.getVertexCount() > 0)
+        draw(&vertices[0], vertices.getVertexCount(), vertices.getPrimitiveType(), states);
+}
+
+void RenderPacket::draw(const sf::Text& text) {
+    Command command;
+    command.type = CommandType::Text;
+    command.index = m_texts.size();
+    m_texts.push_back(text);
+    m_commands.push_back(command);
+}
+
+std::mutex& RenderPacket::fontMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+void RenderPacket::upload(const std::shared_ptr<sf::VertexBuffer>& buffer, const sf::Vertex* vertices, size_t count) {
+    Command command;
+    command.type = CommandType::Upload;
+    command.index = m_vertices.size();
+    command.count = count;
+    command.buffer = m_buffers.size();
+    m_buffers.push_back(buffer);
+    m_vertices.insert(m_vertices.end(), vertices, vertices + count);
+    m_commands.push_back(command);
+}
+
+void RenderPacket::draw(const std::shared_ptr<sf::VertexBuffer>& buffer, size_t count, const sf::RenderStates& states) {
+    if (count == 0)
+        return;
+    Command command;
+    command.type = CommandType::Buffer;
+    command.count = count;
+    command.states = states;
+    command.buffer = m_buffers.size();
+    m_buffers.push_back(buffer);
+    m_commands.push_back(command);
+}
+
+void RenderPacket::beginCache(const std::shared_ptr<RenderCache>& cache, sf::Vector2u size, sf::Color color) {
+    Command command;
+    command.type = CommandType::BeginCache;
+    command.buffer = m_caches.size();
+    command.size = size;
+    command.color = color;
+    m_caches.push_back(cache);
+    m_commands.push_back(command);
+    m_outerView = m_view;
+}
+
+void RenderPacket::endCache() {
+    m_view = m_outerView;
+    Command command;
+    command.type = CommandType::EndCache;
+    m_commands.push_back(command);
+}
+
+void RenderPacket::draw(const std::shared_ptr<RenderCache>& cache, const sf::RenderStates& states) {
+    Command command;
+    command.type = CommandType::Cache;
+    command.buffer = m_caches.size();
+    command.states = states;
+    m_caches.push_back(cache);
+    m_commands.push_back(command);
+}
+
+void RenderPacket::replay(sf::RenderTarget& target) const {
+    // Commands go to the window, or to a cache between BeginCache and EndCache.
+    sf::RenderTarget* current = &target;
+    sf::RenderTexture* cache = nullptr;
+    for (const Command& command : m_commands) {
+        switch (command.type) {
+        case CommandType::Clear:
+            current->clear(command.color);
+            break;
+        case CommandType::View:
+            current->setView(m_views[command.index]);
+            break;
+        case CommandType::Vertices:
+            current->draw(&m_vertices[command.index], command.count, command.primitive, command.states);
+            break;
+        case CommandType::Text: {
+            std::lock_guard<std::mutex> lock(fontMutex());
+            current->draw(m_texts[command.index]);
+            break;
+        }
+        case CommandType::BeginCache:
+            cache = &m_caches[command.buffer]->texture;
+            if (cache->getSize() != command.size && !cache->resize(command.size)) {
+                LOG("Could not create a render texture");
+                throw std::runtime_error("Could not create a render texture");
+            }
+            cache->clear(command.color);
+            current = cache;
+            break;
+        case CommandType::EndCache:
+            if (cache)
+                cache->display();
+            cache = nullptr;
+            current = &target;
+            break;
+        case CommandType::Cache: {
+            const sf::RenderTexture& texture = m_caches[command.buffer]->texture;
+            if (texture.getSize().x > 0)
+                current->draw(sf::Sprite(texture.getTexture()), command.states);
+            break;
+        }
+        case CommandType::Upload: {
+            sf::VertexBuffer& buffer = *m_buffers[command.buffer];
+            // Grow with headroom so small additions do not reallocate every time.
+            if (buffer.getVertexCount() < command.count && !buffer.create(command.count + command.count / 2)) {
+                LOG("Could not allocate a vertex buffer of " + std::to_string(command.count) + " vertices");
+                break;
+            }
+            if (command.count > 0 && !buffer.update(&m_vertices[command.index], command.count, 0))
+                LOG("Could not upload " + std::to_string(command.count) + " vertices to a vertex buffer");
+            break;
+        }
+        case CommandType::Buffer:
+            current->draw(*m_buffers[command.buffer], 0, command.count, command.states);
+            break;
+        }
+    }
+}
+
+size_t RenderPacket::commandCount() const {
+    return m_commands.size();
+}
+
+size_t RenderPacket::vertexCount() const {
+    return m_vertices.size();
+}
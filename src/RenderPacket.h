@@ -0,0 +1,100 @@
+#pragma once
+#ifndef RENDER_PACKET_H
+#define RENDER_PACKET_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/View.hpp>
+
+// RenderPacket is one frame's draw commands, recorded by a scene's sRender and
+// replayed onto the window by the Renderer (possibly on the render thread).
+// It owns copies of everything it draws; the only things it points to are
+// textures, fonts and shaders, which must outlive the frame (assets do).
+// Vertex buffers are shared so they stay alive while a packet uses them, and
+// are only ever uploaded and drawn during replay, on the rendering thread.
+// RenderCaches work the same way for content rendered once into a texture.
+//
+// Consecutive vertex draws with the same list primitive and render states are
+// merged into one draw call.
+// An offscreen image kept between frames (see RenderPacket::beginCache).
+// Only the rendering thread touches the texture.
+struct RenderCache {
+    sf::RenderTexture texture;
+};
+
+class RenderPacket {
+public:
+    // Drop all commands (keeps allocated memory).
+    void reset();
+
+    void clear(sf::Color color = sf::Color::Black);
+    void setView(const sf::View& view);
+    [[nodiscard]] const sf::View& view() const;
+
+    void draw(const sf::Vertex* vertices, size_t count, sf::PrimitiveType type,
+        const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::VertexArray& vertices, const sf::RenderStates& states = sf::RenderStates::Default);
+    // The text is copied and drawn during replay. sf::Font loads glyphs and
+    // pages lazily, both while laying text out and while drawing it, so every
+    // use of a font that can do either must hold fontMutex(); replay holds it
+    // while it draws text.
+    void draw(const sf::Text& text);
+    [[nodiscard]] static std::mutex& fontMutex();
+
+    // Replace the contents of buffer with a copy of vertices before the
+    // commands that follow are replayed.
+    void upload(const std::shared_ptr<sf::VertexBuffer>& buffer, const sf::Vertex* vertices, size_t count);
+    // Draw the first count vertices of buffer.
+    void draw(const std::shared_ptr<sf::VertexBuffer>& buffer, size_t count,
+        const sf::RenderStates& states = sf::RenderStates::Default);
+
+    // Commands recorded between beginCache and endCache are rendered into
+    // cache (resized to size and cleared to color) instead of the target.
+    void beginCache(const std::shared_ptr<RenderCache>& cache, sf::Vector2u size, sf::Color color = sf::Color::Transparent);
+    void endCache();
+    // Draw the cache's last rendered contents with its top-left corner at the origin.
+    void draw(const std::shared_ptr<RenderCache>& cache, const sf::RenderStates& states = sf::RenderStates::Default);
+
+    // Issue every command to target in recording order.
+    void replay(sf::RenderTarget& target) const;
+
+    [[nodiscard]] size_t commandCount() const;
+    [[nodiscard]] size_t vertexCount() const;
+
+private:
+    enum class CommandType { Clear, View, Vertices, Text, Upload, Buffer, BeginCache, EndCache, Cache };
+
+    struct Command {
+        CommandType type = CommandType::Vertices;
+        size_t index = 0; // First vertex, or index into m_views / m_texts.
+        size_t buffer = 0; // Index into m_buffers for Upload and Buffer, m_caches for caches.
+        size_t count = 0;
+        sf::PrimitiveType primitive = sf::PrimitiveType::Triangles;
+        sf::RenderStates states;
+        sf::Color color;
+        sf::Vector2u size;
+    };
+
+    static bool canMerge(const Command& command, sf::PrimitiveType type, const sf::RenderStates& states);
+
+    std::vector<Command> m_commands;
+    std::vector<sf::Vertex> m_vertices;
+    std::vector<sf::View> m_views;
+    std::vector<sf::Text> m_texts;
+    std::vector<std::shared_ptr<sf::VertexBuffer>> m_buffers;
+    std::vector<std::shared_ptr<RenderCache>> m_caches;
+    sf::View m_view;
+    sf::View m_outerView; // Restored by endCache().
+};
+
+#endif // RENDER_PACKET_H
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <array>
+#include <limits>
+#include "RenderQueue.h"
+
+// Fall back to a full radix sort when more than 1/8 of the queue changed.
+static constexpr size_t incrementalRatio = 8;
+
+uint64_t RenderQueue::makeKey(int layer, uint16_t texture, uint32_t depth) {
+    const int biased = std::clamp(layer + 32768, 0, 65535);
+    return (static_cast<uint64_t>(biased) << 48) | (static_cast<uint64_t>(texture) << 32) | depth;
+}
+
+uint16_t RenderQueue::textureId(const sf::Texture* texture) {
+    auto it = m_textureIds.find(texture);
+    if (it != m_textureIds.end())
+        return it->second;
+    const auto id = static_cast<uint16_t>(std::min<size_t>(m_textureIds.size(), std::numeric_limits<uint16_t>::max()));
+    m_textureIds.emplace(texture, id);
+    return id;
+}
+
+void RenderQueue::submit(entt::entity entity, uint64_t key) {
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= m_entries.size())
+        m_entries.resize(index + 1);
+
+    Entry& entry = m_entries[index];
+    const bool unchanged = entry.entity == entity && entry.key == key && entry.seen == m_frame - 1;
+    entry.entity = entity;
+    entry.key = key;
+    entry.seen = m_frame;
+    if (!unchanged)
+        m_changed.push_back({ key, entity });
+}
+
+void RenderQueue::sort() {
+    // Keep last frame's entries that were re-submitted with the same key;
+    // removed, recycled or re-keyed entities are in m_changed if still present.
+    auto stale = [this](const Item& item) {
+        const Entry& entry = m_entries[static_cast<size_t>(entt::to_entity(item.entity))];
+        return entry.entity != item.entity || entry.seen != m_frame || entry.key != item.key;
+    };
+    m_sorted.erase(std::remove_if(m_sorted.begin(), m_sorted.end(), stale), m_sorted.end());
+
+    if (m_changed.size() * incrementalRatio > m_sorted.size()) {
+        m_sorted.insert(m_sorted.end(), m_changed.begin(), m_changed.end());
+        radixSort(m_sorted, m_scratch);
+        m_lastSortCount = m_sorted.size();
+    }
+    else if (!m_changed.empty()) {
+        // std::merge is stable, so unchanged entries keep their relative order.
+        radixSort(m_changed, m_scratch);
+        m_scratch.resize(m_sorted.size() + m_changed.size());
+        std::merge(m_sorted.begin(), m_sorted.end(), m_changed.begin(), m_changed.end(), m_scratch.begin(),
+            [](const Item& a, const Item& b) { return a.key < b.key; });
+        m_sorted.swap(m_scratch);
+        m_lastSortCount = m_changed.size();
+    }
+    else {
+        m_lastSortCount = 0;
+    }
+
+    m_changed.clear();
+    m_frame++;
+}
+
+void RenderQueue::clear() {
+    m_sorted.clear();
+    m_changed.clear();
+    m_entries.clear();
+    m_frame = 1;
+}
+
+const std::vector<RenderQueue::Item>& RenderQueue::items() const {
+    return m_sorted;
+}
+
+size_t RenderQueue::lastSortCount() const {
+    return m_lastSortCount;
+}
+
+// Stable LSD radix sort on the 64-bit key, one byte per pass. Passes where
+// every key has the same byte (common: few layers and textures) are skipped.
+void RenderQueue::radixSort(std::vector<Item>& items, std::vector<Item>& scratch) {
+    const size_t count = items.size();
+    if (count < 2)
+        return;
+    scratch.resize(count);
+
+    std::array<std::array<size_t, 256>, 8> histograms{};
+    for (const Item& item : items) {
+        for (size_t pass = 0; pass < 8; ++pass)
+            histograms[pass][(item.key >> (pass * 8)) & 0xFF]++;
+    }
+
+    for (size_t pass = 0; pass < 8; ++pass) {
+        auto& histogram = histograms[pass];
+        const size_t firstByte = (items[0].key >> (pass * 8)) & 0xFF;
+        if (histogram[firstByte] == count)
+            continue;
+
+        size_t offset = 0;
+        for (auto& bucket : histogram) {
+            const size_t bucketCount = bucket;
+            bucket = offset;
+            offset += bucketCount;
+        }
+        for (const Item& item : items)
+            scratch[histogram[(item.key >> (pass * 8)) & 0xFF]++] = item;
+        items.swap(scratch);
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <entt/entt.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+// RenderQueue keeps renderable entities in draw order using 64-bit sort keys
+// packed from (layer, texture, depth), most significant first:
+//   [63..48] layer, biased so negative layers sort first
+//   [47..32] texture id, so equal-layer sprites batch by texture
+//   [31..0]  depth within the layer (tie-break)
+//
+// Each frame the renderer submit()s every visible entity with its current key
+// and calls sort(). Entities whose key did not change keep their place from
+// the previous frame; only new or changed entries are sorted and merged back
+// in. When many entries changed the whole queue is radix sorted, so ordering
+// never needs a comparison sort over every renderable.
+class RenderQueue {
+public:
+    struct Item {
+        uint64_t key = 0;
+        entt::entity entity = entt::null;
+    };
+
+    [[nodiscard]] static uint64_t makeKey(int layer, uint16_t texture, uint32_t depth);
+
+    // Small stable id for a texture, for use in makeKey.
+    uint16_t textureId(const sf::Texture* texture);
+
+    // Add or refresh an entity for this frame. Call at most once per entity per frame.
+    void submit(entt::entity entity, uint64_t key);
+
+    // Drop entities not submitted since the last sort and restore key order.
+    void sort();
+
+    // Remove everything (e.g. when the scene is rebuilt).
+    void clear();
+
+    [[nodiscard]] const std::vector<Item>& items() const;
+
+    // Entries sorted by the last sort() call (all of them after a full rebuild).
+    [[nodiscard]] size_t lastSortCount() const;
+
+private:
+    struct Entry {
+        entt::entity entity = entt::null;
+        uint64_t key = 0;
+        uint32_t seen = 0;
+    };
+
+    static void radixSort(std::vector<Item>& items, std::vector<Item>& scratch);
+
+    std::vector<Item> m_sorted;
+    std::vector<Item> m_changed;
+    std::vector<Item> m_scratch;
+    std::vector<Entry> m_entries; // Indexed by entity index.
+    std::unordered_map<const sf::Texture*, uint16_t> m_textureIds;
+    uint32_t m_frame = 1;
+    size_t m_lastSortCount = 0;
+};
+
+#endif // RENDER_QUEUE_H
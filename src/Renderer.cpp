@@ -0,0 +1,153 @@
+#include <stdexcept>
+#include <utility>
+#include "imgui-SFML.h"
+#include "Renderer.h"
+#include "Logger.h"
+#include "Profiler.h"
+
+Renderer::Renderer(sf::RenderWindow& window, bool threaded)
+    : m_window(window)
+    , m_threaded(threaded)
+{
+    if (!m_threaded)
+        return;
+
+    // A GL context can only be current on one thread at a time.
+    if (!m_window.setActive(false)) {
+        LOG("Could not release the window context; rendering on the main thread");
+        m_threaded = false;
+        return;
+    }
+    m_thread = std::thread([this] { renderLoop(); });
+}
+
+Renderer::~Renderer() {
+    stop();
+}
+
+bool Renderer::isThreaded() const {
+    return m_threaded;
+}
+
+void Renderer::beginFrame() {
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wake.wait(lock, [this] { return m_imguiDone || m_error; });
+    }
+    rethrowError();
+    m_packets[m_back].reset();
+}
+
+RenderPacket& Renderer::packet() {
+    return m_packets[m_back];
+}
+
+void Renderer::submit() {
+    if (!m_threaded) {
+        renderFrame(m_packets[m_back]);
+        return;
+    }
+
+    {
+        PROFILE_SCOPE("Renderer::wait");
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wake.wait(lock, [this] { return (!m_pending && !m_busy) || m_error; });
+        if (!m_error) {
+            // The render thread takes the recorded packet; record into the other one.
+            m_back = 1 - m_back;
+            m_pending = true;
+            m_imguiDone = false;
+        }
+    }
+    m_wake.notify_all();
+    rethrowError();
+}
+
+void Renderer::stop() {
+    if (!m_thread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_wake.notify_all();
+    m_thread.join();
+    if (!m_window.setActive(true))
+        LOG("Could not reactivate the window context on the main thread");
+}
+
+void Renderer::rethrowError() {
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        error = std::exchange(m_error, nullptr);
+    }
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void Renderer::renderLoop() {
+    Profiler::getInstance().setThreadName("Render");
+    if (!m_window.setActive(true)) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_error = std::make_exception_ptr(std::runtime_error("Could not activate the window context on the render thread"));
+        m_wake.notify_all();
+        return;
+    }
+
+    while (true) {
+        size_t front = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_pending || !m_running; });
+            // Draw a frame that was submitted before stop() so it is not lost.
+            if (!m_pending)
+                break;
+            m_pending = false;
+            m_busy = true;
+            front = 1 - m_back;
+        }
+
+        try {
+            renderFrame(m_packets[front]);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_error = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_busy = false;
+            m_imguiDone = true;
+        }
+        m_wake.notify_all();
+    }
+
+    if (!m_window.setActive(false))
+        LOG("Could not release the window context on the render thread");
+}
+
+void Renderer::renderFrame(const RenderPacket& packet) {
+    {
+        PROFILE_SCOPE("RenderPacket::replay");
+        packet.replay(m_window);
+    }
+    {
+        PROFILE_SCOPE("ImGui::SFML::Render");
+        ImGui::SFML::Render(m_window);
+    }
+    if (m_threaded) {
+        // ImGui's draw data has been consumed; the main thread may start its next frame.
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_imguiDone = true;
+        }
+        m_wake.notify_all();
+    }
+    {
+        PROFILE_SCOPE("Window::display");
+        m_window.display();
+    }
+}
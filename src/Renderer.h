@@ -0,0 +1,69 @@
+#pragma once
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include "RenderPacket.h"
+
+// Renderer owns drawing to the window. Each frame the main thread records a
+// RenderPacket and submits it; when threaded, a dedicated render thread owns
+// the window's GL context and replays the packet, renders ImGui and calls
+// display(), so the main thread can simulate the next frame meanwhile.
+//
+// Packets are double-buffered: one is recorded while the other is drawn, and
+// submit() waits for the previous frame to be displayed before swapping. ImGui
+// is a single global context, so the main thread calls beginFrame() (which
+// waits until the render thread is done with last frame's ImGui draw data)
+// before feeding ImGui events or starting a new ImGui frame.
+//
+// Window events stay on the main thread; only the render thread draws.
+class Renderer {
+public:
+    Renderer(sf::RenderWindow& window, bool threaded);
+    ~Renderer();
+
+    Renderer(const Renderer&) = delete;
+    Renderer& operator=(const Renderer&) = delete;
+
+    // Wait until ImGui may be used again and start recording a new packet.
+    void beginFrame();
+
+    // The packet being recorded this frame.
+    [[nodiscard]] RenderPacket& packet();
+
+    // Hand the recorded packet to the render thread (or draw it right away
+    // when not threaded). Rethrows errors raised while drawing.
+    void submit();
+
+    // Finish the frame in flight, join the render thread and make the
+    // window's context current on the calling thread again.
+    void stop();
+
+    [[nodiscard]] bool isThreaded() const;
+
+private:
+    void renderLoop();
+    void renderFrame(const RenderPacket& packet);
+    void rethrowError();
+
+    sf::RenderWindow& m_window;
+    bool m_threaded;
+
+    RenderPacket m_packets[2];
+    size_t m_back = 0; // Packet being recorded; the other one is drawn.
+
+    std::thread m_thread;
+    std::mutex m_mutex; // Guards the flags below.
+    std::condition_variable m_wake;
+    bool m_running = true;
+    bool m_pending = false;   // A submitted packet has not been picked up yet.
+    bool m_busy = false;      // The render thread is drawing or displaying.
+    bool m_imguiDone = true;  // Last frame's ImGui draw data has been rendered.
+    std::exception_ptr m_error;
+};
+
+#endif // RENDERER_H
@@ -1,20 +1,51 @@
 #include "Scene.h"
 #include "GameEngine.h"
+#include "Profiler.h"
 
 Scene::Scene(GameEngine* gameEngine)
     : m_game(gameEngine) {
 }
 
+void Scene::onActivate() {
+}
+
 void Scene::doAction(const Action& action) {
+    markDirty();
     sDoAction(action);
 }
 
 void Scene::setPaused(bool paused) {
     m_paused = paused;
+    markDirty();
+}
+
+bool Scene::isPaused() const {
+    return m_paused;
+}
+
+void Scene::markDirty() {
+    m_dirty = true;
+}
+
+void Scene::clearDirty() {
+    m_dirty = false;
+}
+
+bool Scene::isDirty() const {
+    return m_dirty;
+}
+
+bool Scene::isAnimating() const {
+    return false;
 }
 
-void Scene::simulate(const size_t /*frames*/) {
-    // Default implementation: no simulation step.
+void Scene::simulate(const size_t frames) {
+    // Each tick is a profiler frame, so zone buffers are drained as they fill.
+    for (size_t i = 0; i < frames && !m_hasEnded; ++i) {
+        Profiler::getInstance().beginFrame();
+        update();
+        Profiler::getInstance().endFrame();
+    }
 }
 
 void Scene::registerAction(int inputKey, const ActionName& actionName) {
@@ -22,17 +53,25 @@ void Scene::registerAction(int inputKey, const ActionName& actionName) {
 }
 
 float Scene::width() const {
-    return static_cast<float>(m_game->window().getSize().x);
+    return static_cast<float>(m_game->viewSize().x);
 }
 
 float Scene::height() const {
-    return static_cast<float>(m_game->window().getSize().y);
+    return static_cast<float>(m_game->viewSize().y);
+}
+
+void Scene::setInterpolation(float alpha) {
+    m_interpolation = alpha;
 }
 
 size_t Scene::currentFrame() const {
     return m_currentFrame;
 }
 
+float Scene::interpolation() const {
+    return m_interpolation;
+}
+
 bool Scene::hasEnded() const {
     return m_hasEnded;
 }
@@ -41,9 +80,13 @@ const ActionMap& Scene::getActionMap() const {
     return m_actionMap;
 }
 
-void Scene::drawLine(const sf::Vector2f& p1, const sf::Vector2f& p2) {
-    sf::Vertex vertices[2];
-    vertices[0].position = p1;
-    vertices[1].position = p2;
-    m_game->window().draw(vertices, 2, sf::PrimitiveType::Lines);
+void Scene::drawLine(const sf::Vector2f& p1, const sf::Vector2f& p2, sf::Color color, float width, int layer) {
+    // Headless runs have no renderer and nothing is ever drawn.
+    if (m_game->isHeadless())
+        return;
+    m_lines.add(p1, p2, color, width, layer);
+}
+
+void Scene::submitLines(RenderPacket& packet) {
+    m_lines.submit(packet);
 }
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include <SFML/Graphics.hpp>
 #include <entt/entt.hpp>
 #include "Action.h"
+#include "LineBatch.h"
+#include "SystemScheduler.h"
 
 // Using a map to associate input keys with action names.
 using ActionMap = std::unordered_map<int, ActionName>;
@@ -17,11 +19,19 @@ protected:
     GameEngine* m_game = nullptr;
     // Use entt registry for managing entities and components (see Components.hpp for component definitions).
     entt::registry m_registry;
+    // Simulation systems run by update(); see SystemScheduler for the access rules.
+    SystemScheduler m_systems;
     ActionMap m_actionMap;
     bool m_paused = false;
     bool m_hasEnded = false;
     size_t m_currentFrame = 0;
+    // Fraction [0, 1) of a simulation tick elapsed since the last update().
+    float m_interpolation = 0.f;
+    // Something visible changed since the last rendered frame.
+    bool m_dirty = true;
     float m_music_volume = 25.0f;
+    // Segments queued by drawLine this frame.
+    LineBatch m_lines;
 
     // Called when the scene ends  must be implemented by derived scenes.
     virtual void onEnd() = 0;
@@ -34,19 +44,40 @@ public:
     explicit Scene(GameEngine* gameEngine);
     virtual ~Scene() = default;
 
-    // Update logic specific to the scene.
+    // Advance the simulation by one fixed tick; must not draw.
     virtual void update() = 0;
 
     // Handle input actions; to be implemented by derived scenes.
     virtual void sDoAction(const Action& action) = 0;
 
-    // Render the scene; must be implemented by subclasses.
+    // Record the scene's draw commands into the engine's render packet once per
+    // displayed frame; must be implemented by subclasses. Never draw to the
+    // window directly: it may belong to the render thread.
     virtual void sRender() = 0;
 
+    // Set the blend factor between the previous and current simulation state.
+    void setInterpolation(float alpha);
+
+    // Called on the main thread when the scene becomes current. Scenes built
+    // by changeSceneAsync do their audio, window and GPU setup here.
+    virtual void onActivate();
+
+    // Idle tracking: the engine only renders a frame when the scene is dirty
+    // or animating. Input marks the scene dirty; scenes mark it themselves
+    // when their state changes (e.g. after a simulation tick).
+    void markDirty();
+    void clearDirty();
+    [[nodiscard]] bool isDirty() const;
+    // Whether the scene changes on screen every frame with no new input or
+    // ticks (e.g. a camera pan while a key is held).
+    [[nodiscard]] virtual bool isAnimating() const;
+    [[nodiscard]] bool isPaused() const;
+
     // Wraps the scene-specific action handler.
     virtual void doAction(const Action& action);
 
-    // Simulate the scene for a given number of frames (default: no simulation step).
+    // Run the given number of simulation ticks back to back, without rendering.
+    // Each tick is one profiler frame.
     virtual void simulate(size_t frames);
 
     // Associate an input key with an action name.
@@ -56,11 +87,19 @@ public:
     [[nodiscard]] float width() const;
     [[nodiscard]] float height() const;
     [[nodiscard]] size_t currentFrame() const;
+    [[nodiscard]] float interpolation() const;
     [[nodiscard]] bool hasEnded() const;
     [[nodiscard]] const ActionMap& getActionMap() const;
 
-    // Draw a line between two points.
-    void drawLine(const sf::Vector2f& p1, const sf::Vector2f& p2);
+    // Queue a line between two points for this frame; width is in world units
+    // (0 for a hairline). Lines outside the view they are recorded under are
+    // culled when submitted.
+    // sRender may record a layer's lines with m_lines.submit(packet, layer);
+    // anything left is drawn on top by submitLines after sRender. Does
+    // nothing in headless runs.
+    void drawLine(const sf::Vector2f& p1, const sf::Vector2f& p2, sf::Color color = sf::Color::White,
+        float width = 0.f, int layer = 0);
+    void submitLines(RenderPacket& packet);
 };
 
 #endif // SCENE_H
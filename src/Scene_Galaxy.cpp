@@ -2,11 +2,45 @@
 #include "Components.hpp"   // For Transform2D, Renderable, and Input components
 #include "GameEngine.h"
 #include <SFML/Graphics.hpp>
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <optional>
 
 // Global enlargement factor for the background
 static constexpr float bgScale = 2.0f;
 
+// Level of detail, in screen pixels: renderables smaller than impostorPixels
+// are drawn as points, and once the view is zoomed out past
+// clusterUnitsPerPixel world units per pixel the hierarchy's clusters (about
+// clusterPixels wide) replace individual entities altogether.
+static constexpr float impostorPixels = 6.f;
+static constexpr float pointPixels = 2.f;
+static constexpr float clusterUnitsPerPixel = 40.f;
+static constexpr float clusterPixels = 24.f;
+
+// World-space box that contains a renderable wherever it is drawn between the
+// previous and current tick, at any rotation.
+static sf::FloatRect renderBounds(const TextureRegion& region, const Transform2D& transform, const Orientation& orientation) {
+	// Regions are drawn centred on the position.
+	const float maxX = static_cast<float>(region.rect.size.x) / 2.f * std::abs(orientation.scale.x);
+	const float maxY = static_cast<float>(region.rect.size.y) / 2.f * std::abs(orientation.scale.y);
+	const float radius = std::sqrt(maxX * maxX + maxY * maxY);
+
+	const sf::Vector2f min(std::min(transform.position.x, transform.prevPosition.x) - radius,
+		std::min(transform.position.y, transform.prevPosition.y) - radius);
+	const sf::Vector2f max(std::max(transform.position.x, transform.prevPosition.x) + radius,
+		std::max(transform.position.y, transform.prevPosition.y) + radius);
+	return sf::FloatRect(min, max - min);
+}
+
+// Orientation is optional; without one a quad is drawn unrotated and unscaled.
+static const Orientation& orientationOf(const entt::registry& registry, entt::entity entity) {
+	static const Orientation identity;
+	const auto* orientation = registry.try_get<Orientation>(entity);
+	return orientation ? *orientation : identity;
+}
+
 Scene_Galaxy::Scene_Galaxy(GameEngine* gameEngine)
 	: Scene(gameEngine)
 {
@@ -21,28 +55,122 @@ void Scene_Galaxy::init() {
 	registerAction(static_cast<int>(sf::Keyboard::Scancode::S), ActionName::Down);
 	registerAction(static_cast<int>(sf::Keyboard::Scancode::M), ActionName::Mute);
 
-	// Retrieve music from Assets and play it.
-	m_music = &m_game->assets().getSound("BackgroundMusic2");
-	m_music->play();
+	// Pack moving entities before any are created.
+	Motion::group(m_registry);
+	m_broadphase.connect(m_registry);
+	m_world.connect(m_registry);
+	registerSystems();
+
+	// Keep the render index in sync as renderables come and go.
+	m_registry.on_construct<Renderable>().connect<&Scene_Galaxy::onRenderableConstruct>(this);
+	m_registry.on_destroy<Renderable>().connect<&Scene_Galaxy::onRenderableDestroy>(this);
+	// sRenderIndex only follows entities with Movement; others are re-indexed,
+	// and their static quad rebuilt, when their Transform2D or Orientation is
+	// patched or replaced.
+	m_registry.on_update<Transform2D>().connect<&Scene_Galaxy::onPlacementUpdate>(this);
+	m_registry.on_update<Orientation>().connect<&Scene_Galaxy::onPlacementUpdate>(this);
+	// Renderables move between the static and dynamic paths as they gain or lose Movement.
+	m_registry.on_construct<Movement>().connect<&Scene_Galaxy::onMovementConstruct>(this);
+	m_registry.on_destroy<Movement>().connect<&Scene_Galaxy::onMovementDestroy>(this);
 
 	// --- Set Up Camera Entity ---
 	m_camera = m_registry.create();
 	m_registry.emplace<Input>(m_camera);
 
-	// --- Setup Background for Looping & Enlarging ---
-	const sf::Texture& bgTex = m_game->assets().getTexture("galaxy_bg");
-	// Ensure that bgTex.setRepeated(true) is called during asset loading.
-	m_background = std::make_unique<sf::Sprite>(bgTex);
-	// Set the scale so that one tile's size in world space equals (texture size * bgScale)
-	m_background->setScale({ bgScale, bgScale });
-	// (We will draw a grid of tiles in sRender.)
-
 	// --- Create Example Entities (e.g., planets) ---
 	// Loop to create planets via the SpawnPlanet function.
-	for (int i = 0; i < 3; ++i) {
+	const int planetCount = 3;
+	for (int i = 0; i < planetCount; ++i) {
 		sf::Vector2f pos(200.f + i * 300.f, 300.f + (i % 2) * 150.f);
 		sf::Vector2f scale(0.2f, 0.2f);
 		SpawnPlanet(pos, scale);
+		m_game->setLoadProgress(static_cast<float>(i + 1) / static_cast<float>(planetCount));
+	}
+
+	m_view = sf::View(sf::FloatRect({ 0.f, 0.f }, { width(), height() }));
+
+	// Headless runs have no assets, audio or window; simulation only.
+	if (m_game->isHeadless())
+		return;
+
+	// Look the music up now; it starts playing once the scene is activated.
+	m_music = &m_game->assets().getSound("BackgroundMusic2");
+
+	// --- Setup Background for Looping & Enlarging ---
+	// galaxy_bg is loaded with "repeated": true so one quad can tile it.
+	m_backgroundTexture = &m_game->assets().getTexture("galaxy_bg");
+
+	// Parallax star layers in front of the nebula, far to near.
+	m_starfield.addLayer({ 0.2f, 256.f, 6, 1.f, 2.f, sf::Color(180, 190, 255, 160) });
+	m_starfield.addLayer({ 0.5f, 384.f, 4, 1.5f, 3.f, sf::Color(220, 225, 255, 200) });
+	m_starfield.addLayer({ 0.8f, 512.f, 3, 2.f, 4.f, sf::Color(255, 250, 235, 255) });
+}
+
+void Scene_Galaxy::onActivate() {
+	if (m_music)
+		m_music->play();
+}
+
+// Register the per-tick simulation systems and the components they touch.
+// Systems that conflict run in the order they are added here.
+void Scene_Galaxy::registerSystems() {
+	m_systems.add("Movement", Reads<Movement>{}, Writes<Transform2D, Velocity>{}, [this] { sMovement(); });
+	m_systems.add("Broadphase", Reads<Transform2D, Orientation, BoxCollider, CircleCollider, ComplexCollider, Movement>{},
+		Writes<Resource<Broadphase>>{}, [this] { sBroadphase(); });
+	m_systems.add("Narrowphase", Reads<Resource<Broadphase>, Transform2D, Orientation, BoxCollider, CircleCollider, ComplexCollider>{},
+		Writes<Resource<Narrowphase>>{}, [this] { sNarrowphase(); });
+	m_systems.add("Projectiles", Reads<Resource<Broadphase>, Transform2D, Orientation, TBullet, TProjectile, BoxCollider, CircleCollider, ComplexCollider>{},
+		Writes<Resource<ContinuousCollision>>{}, [this] { sProjectiles(); });
+	m_systems.add("WorldQuery", Reads<Transform2D, Orientation, BoxCollider, CircleCollider, ComplexCollider, Movement>{},
+		Writes<Resource<WorldQuery>>{}, [this] { sWorldQuery(); });
+	// m_renderIndex is the scene's only SpatialGrid resource.
+	m_systems.add("RenderIndex", Reads<Transform2D, Orientation, Renderable, Movement>{},
+		Writes<Resource<SpatialGrid>, Resource<LodHierarchy>>{}, [this] { sRenderIndex(); });
+}
+
+void Scene_Galaxy::onRenderableConstruct(entt::registry& registry, entt::entity entity) {
+	if (const auto* transform = registry.try_get<Transform2D>(entity)) {
+		const auto& renderable = registry.get<Renderable>(entity);
+		const TextureRegion& region = m_game->assets().getRegion(renderable.region);
+		const Orientation& orientation = orientationOf(registry, entity);
+		m_renderIndex.insert(entity, renderBounds(region, *transform, orientation));
+		const auto* impostor = registry.try_get<Impostor>(entity);
+		m_lod.insert(entity, transform->position, impostor ? impostor->color : sf::Color::White);
+		if (!registry.all_of<Movement>(entity))
+			m_staticGeometry.add(entity, renderable.layer, region, transform->position, orientation.rotation, orientation.scale, renderable.tint);
+	}
+}
+
+void Scene_Galaxy::onRenderableDestroy(entt::registry& /*registry*/, entt::entity entity) {
+	m_renderIndex.remove(entity);
+	m_lod.remove(entity);
+	m_staticGeometry.remove(entity);
+}
+
+void Scene_Galaxy::onPlacementUpdate(entt::registry& registry, entt::entity entity) {
+	if (registry.all_of<Movement>(entity) || !registry.all_of<Renderable, Transform2D>(entity))
+		return;
+	const auto& transform = registry.get<Transform2D>(entity);
+	const auto& renderable = registry.get<Renderable>(entity);
+	const TextureRegion& region = m_game->assets().getRegion(renderable.region);
+	const Orientation& orientation = orientationOf(registry, entity);
+	m_renderIndex.update(entity, renderBounds(region, transform, orientation));
+	m_lod.update(entity, transform.position);
+	// Replaces the cached quad, possibly in another chunk.
+	m_staticGeometry.add(entity, renderable.layer, region, transform.position, orientation.rotation, orientation.scale, renderable.tint);
+}
+
+void Scene_Galaxy::onMovementConstruct(entt::registry& /*registry*/, entt::entity entity) {
+	m_staticGeometry.remove(entity);
+}
+
+void Scene_Galaxy::onMovementDestroy(entt::registry& registry, entt::entity entity) {
+	const auto* renderable = registry.try_get<Renderable>(entity);
+	const auto* transform = registry.try_get<Transform2D>(entity);
+	if (renderable && transform) {
+		const Orientation& orientation = orientationOf(registry, entity);
+		m_staticGeometry.add(entity, renderable->layer, m_game->assets().getRegion(renderable->region), transform->position,
+			orientation.rotation, orientation.scale, renderable->tint);
 	}
 }
 
@@ -50,25 +178,27 @@ void Scene_Galaxy::init() {
 void Scene_Galaxy::SpawnPlanet(const sf::Vector2f& position, const sf::Vector2f& scale) {
 	auto entity = m_registry.create();
 
-	// Set up Transform2D component.
+	// Set up Transform2D and Orientation components.
 	Transform2D trans;
 	trans.position = position;
-	trans.scale = scale;
+	trans.prevPosition = position;
 	m_registry.emplace<Transform2D>(entity, trans);
+	m_registry.emplace<Orientation>(entity, 0.f, scale);
+
+	if (m_game->isHeadless())
+		return;
 
-	// Create the planet sprite.
-	sf::Sprite planetSprite(m_game->assets().getTexture("planet"));
-	sf::FloatRect bounds = planetSprite.getLocalBounds();
-	planetSprite.setOrigin({ bounds.size.x / 2.f, bounds.size.y / 2.f });
-	planetSprite.setScale(scale);
-	Renderable renderable{ planetSprite, 1 }; // layer = 1
+	// The planet region may be a slot of a shared atlas page.
+	const RegionId planetRegion = m_game->assets().getRegionId("planet");
+	// The impostor must exist before the Renderable, which registers the entity for LOD.
+	m_registry.emplace<Impostor>(entity, m_game->assets().getRegion(planetRegion).average);
+	Renderable renderable{ planetRegion, sf::Color::White, 1 }; // layer = 1
 	m_registry.emplace<Renderable>(entity, renderable);
 }
 
 void Scene_Galaxy::sCamera() {
 	// Update the view based on the camera entity's Input component.
 	auto& camInput = m_registry.get<Input>(m_camera);
-	m_view = m_game->window().getView();
 	const float panSpeed = 5.f;
 
 	if (camInput.left)
@@ -79,8 +209,6 @@ void Scene_Galaxy::sCamera() {
 		m_view.move({ 0.f, -panSpeed });
 	if (camInput.down)
 		m_view.move({ 0.f, panSpeed });
-
-	m_game->window().setView(m_view);
 }
 
 void Scene_Galaxy::sDoAction(const Action& action) {
@@ -92,15 +220,11 @@ void Scene_Galaxy::sDoAction(const Action& action) {
 		case ActionName::Right:  input.right = true; break;
 		case ActionName::Up:     input.up = true; break;
 		case ActionName::Down:   input.down = true; break;
-		case ActionName::ScrollUp:		
-			m_view = m_game->window().getView();
+		case ActionName::ScrollUp:
 			m_view.zoom(0.9f);
-			m_game->window().setView(m_view);
 			break;
 		case ActionName::ScrollDown:
-			m_view = m_game->window().getView();
 			m_view.zoom(1.1f);
-			m_game->window().setView(m_view);
 			break;
 		case ActionName::Mute:
 			if (m_music->getVolume()) {
@@ -126,41 +250,191 @@ void Scene_Galaxy::sDoAction(const Action& action) {
 	}
 }
 
+// Step the motion group (Transform2D, Velocity, Movement): add each entity's
+// acceleration to its velocity, clamp the speed to maxSpeed (when positive),
+// then move it, keeping the old position as prevPosition for interpolation.
+void Scene_Galaxy::sMovement() {
+	Motion::integrate(m_registry, m_game->tickTime().asSeconds());
+}
+
+// Candidate collision pairs for the narrowphase; static colliders are
+// re-indexed by Broadphase's own hooks, not here.
+void Scene_Galaxy::sBroadphase() {
+	m_broadphase.update(m_registry);
+	m_broadphase.findPairs(m_game->jobs());
+}
+
+// Exact overlaps of the candidate pairs. Contacts must touch on a side this
+// tick, so no extra penetration tolerance is allowed.
+void Scene_Galaxy::sNarrowphase() {
+	m_narrowphase.run(m_broadphase.pairs(), m_registry, { 0.f, 0.f });
+}
+
+// Projectiles can cross a target within one tick, so they are swept along
+// their whole path rather than tested where they end up.
+void Scene_Galaxy::sProjectiles() {
+	m_ccd.sweep(m_registry, m_broadphase, m_game->jobs());
+}
+
+// Bring the query tree up to date so later systems can raycast and overlap.
+void Scene_Galaxy::sWorldQuery() {
+	m_world.update(m_registry);
+}
+
+// Entities with Movement are refreshed every tick; static ones are indexed
+// when their Renderable is added and again by onPlacementUpdate.
+void Scene_Galaxy::sRenderIndex() {
+	const auto& regions = m_game->assets().getRegions();
+	auto moving = m_registry.view<const Transform2D, const Renderable, const Movement>();
+	for (auto entity : moving) {
+		const auto& transform = moving.get<const Transform2D>(entity);
+		m_renderIndex.update(entity, renderBounds(regions[moving.get<const Renderable>(entity).region], transform,
+			orientationOf(m_registry, entity)));
+		m_lod.update(entity, transform.position);
+	}
+}
+
+// Fit the background quad to the view. Texture coordinates run past the
+// texture's edges and the repeated texture wraps them, so any zoom is covered
+// by one quad. They are offset by whole tiles to stay small far from the origin.
+void Scene_Galaxy::sBackground(const sf::FloatRect& viewRect) {
+	const sf::Vector2u texSize = m_backgroundTexture->getSize();
+	const Vector2f tile(static_cast<float>(texSize.x), static_cast<float>(texSize.y));
+	const Vector2f start(viewRect.position.x / bgScale, viewRect.position.y / bgScale);
+	const Vector2f wrapped(start.x - std::floor(start.x / tile.x) * tile.x, start.y - std::floor(start.y / tile.y) * tile.y);
+	const Vector2f extent = viewRect.size / bgScale;
+
+	const Vector2f min = viewRect.position;
+	const Vector2f max = viewRect.position + viewRect.size;
+	m_background[0] = sf::Vertex{ min, sf::Color::White, wrapped };
+	m_background[1] = sf::Vertex{ { max.x, min.y }, sf::Color::White, { wrapped.x + extent.x, wrapped.y } };
+	m_background[2] = sf::Vertex{ { min.x, max.y }, sf::Color::White, { wrapped.x, wrapped.y + extent.y } };
+	m_background[3] = sf::Vertex{ max, sf::Color::White, wrapped + extent };
+}
+
 void Scene_Galaxy::sRender() {
-	// Get the current view.
-	sf::View currentView = m_game->window().getView();
-	sf::Vector2f viewCenter = currentView.getCenter();
-
-	// Retrieve the background texture's original size.
-	const sf::Texture& bgTex = m_game->assets().getTexture("galaxy_bg");
-	sf::Vector2u texSize = bgTex.getSize();
-	// Compute the tile size in world space.
-	sf::Vector2f tileSize(static_cast<float>(texSize.x) * bgScale, static_cast<float>(texSize.y) * bgScale);
-
-	// Align the grid with world coordinates.
-	float startX = std::floor(viewCenter.x / tileSize.x) * tileSize.x;
-	float startY = std::floor(viewCenter.y / tileSize.y) * tileSize.y;
-
-	// Draw a 3x3 grid of background tiles.
-	for (int i = -1; i <= 1; i++) {
-		for (int j = -1; j <= 1; j++) {
-			// Copy the base background sprite.
-			sf::Sprite tileSprite(*m_background);
-			// Set the texture rectangle to show the entire tile.
-			tileSprite.setTextureRect(sf::IntRect({ 0, 0 }, { static_cast<int>(texSize.x), static_cast<int>(texSize.y) }));
-			// Position the tile in the grid.
-			tileSprite.setPosition({ startX + i * tileSize.x, startY + j * tileSize.y });
-			m_game->window().draw(tileSprite);
+	// The camera follows input at display rate, independent of game speed.
+	sCamera();
+
+	RenderPacket& packet = m_game->renderPacket();
+	packet.setView(m_view);
+	const sf::Vector2f viewCenter = m_view.getCenter();
+	const sf::FloatRect viewRect(viewCenter - m_view.getSize() / 2.f, m_view.getSize());
+
+	// Backdrop: the tiled nebula, then the star layers.
+	sBackground(viewRect);
+	packet.draw(m_background, sf::RenderStates(m_backgroundTexture));
+	m_starfield.update(viewRect);
+	m_starfield.submit(packet);
+
+	const float unitsPerPixel = viewRect.size.x / static_cast<float>(m_game->window().getSize().x);
+	if (unitsPerPixel >= clusterUnitsPerPixel) {
+		sRenderClusters(viewRect, unitsPerPixel);
+		return;
+	}
+
+	// Static renderables come from cached vertex buffers while their chunk is
+	// large enough on screen to draw as sprites.
+	m_staticGeometry.cull(viewRect, impostorPixels * unitsPerPixel);
+
+	// Queue the other entities inside the view by layer, then texture; entity
+	// index breaks ties. Those too small to see as sprites become points.
+	m_visible.clear();
+	m_renderIndex.query(viewRect, m_visible);
+	m_lodVertices.clear();
+	const auto& regions = m_game->assets().getRegions();
+	auto viewEntities = m_registry.view<const Renderable, const Transform2D>();
+	for (auto entity : m_visible) {
+		if (m_staticGeometry.drawn(entity))
+			continue;
+		const auto& renderable = viewEntities.get<const Renderable>(entity);
+		const sf::FloatRect& bounds = m_renderIndex.bounds(entity);
+		if (std::max(bounds.size.x, bounds.size.y) < impostorPixels * unitsPerPixel) {
+			const auto& transform = viewEntities.get<const Transform2D>(entity);
+			const Vector2f position = transform.prevPosition + (transform.position - transform.prevPosition) * m_interpolation;
+			addImpostor(position, pointPixels * unitsPerPixel, m_lod.color(entity), false);
+			continue;
+		}
+		const uint16_t texture = m_renderQueue.textureId(regions[renderable.region].texture);
+		m_renderQueue.submit(entity, RenderQueue::makeKey(renderable.layer, texture, static_cast<uint32_t>(entt::to_entity(entity))));
+	}
+	m_renderQueue.sort();
+
+	// Impostor points sit below every sprite layer.
+	packet.draw(m_lodVertices);
+
+	// Draw layer by layer: a layer's static chunks, then its queued entities
+	// as batched quads in queue order, then its lines.
+	m_staticLayers.clear();
+	m_staticGeometry.visibleLayers(m_staticLayers);
+	m_lineLayers.clear();
+	m_lines.layers(m_lineLayers);
+	auto nextStatic = m_staticLayers.begin();
+	auto nextLine = m_lineLayers.begin();
+	// Everything below layer, then the static chunks of layer itself.
+	auto submitUpTo = [&](int layer) {
+		for (;;) {
+			const bool hasStatic = nextStatic != m_staticLayers.end() && *nextStatic <= layer;
+			const bool hasLine = nextLine != m_lineLayers.end() && *nextLine < layer;
+			if (hasStatic && (!hasLine || *nextStatic <= *nextLine))
+				m_staticGeometry.submit(packet, *nextStatic++);
+			else if (hasLine)
+				m_lines.submit(packet, *nextLine++);
+			else
+				break;
+		}
+	};
+	m_spriteBatch.clear();
+	std::optional<int> batchLayer;
+	for (const auto& item : m_renderQueue.items()) {
+		const auto& renderable = viewEntities.get<const Renderable>(item.entity);
+		if (batchLayer != renderable.layer) {
+			m_spriteBatch.submit(packet);
+			m_spriteBatch.clear();
+			submitUpTo(renderable.layer);
+			batchLayer = renderable.layer;
 		}
+		const auto& transform = viewEntities.get<const Transform2D>(item.entity);
+		// Blend between the last two ticks so motion stays smooth at any tick rate.
+		const Vector2f position = transform.prevPosition + (transform.position - transform.prevPosition) * m_interpolation;
+		const Orientation& orientation = orientationOf(m_registry, item.entity);
+		m_spriteBatch.add(regions[renderable.region], position, orientation.rotation, orientation.scale, renderable.tint);
 	}
+	m_spriteBatch.submit(packet);
+	submitUpTo(std::numeric_limits<int>::max());
+}
+
+// Extreme zoom-out: one soft splat per hierarchy cell in view, sized and
+// brightened by how many entities it holds. Cost depends on the view, not on
+// the number of entities.
+void Scene_Galaxy::sRenderClusters(const sf::FloatRect& viewRect, float unitsPerPixel) {
+	const size_t level = m_lod.levelFor(clusterPixels * unitsPerPixel);
+	const float cellSize = m_lod.cellSize(level);
+	m_clusters.clear();
+	m_lod.query(level, viewRect, m_clusters);
+
+	m_lodVertices.clear();
+	for (const auto& cluster : m_clusters) {
+		const float density = std::log2(static_cast<float>(cluster.count) + 1.f);
+		const float radius = std::max(cellSize * std::min(0.5f, 0.15f + 0.05f * density), pointPixels * unitsPerPixel);
+		sf::Color color = cluster.color;
+		color.a = static_cast<uint8_t>(std::min(255.f, 90.f + 30.f * density));
+		addImpostor(cluster.center, radius, color, true);
+	}
+	m_game->renderPacket().draw(m_lodVertices);
+}
 
-	// Draw other entities (e.g. planets).
-	auto viewEntities = m_registry.view<Renderable, Transform2D>();
-	for (auto entity : viewEntities) {
-		auto& renderable = viewEntities.get<Renderable>(entity);
-		auto& transform = viewEntities.get<Transform2D>(entity);
-		renderable.sprite.setPosition(transform.position);
-		m_game->window().draw(renderable.sprite);
+// A diamond of four triangles; soft ones fade from the centre to the edge.
+void Scene_Galaxy::addImpostor(const Vector2f& center, float radius, sf::Color color, bool soft) {
+	sf::Color edge = color;
+	if (soft)
+		edge.a = 0;
+	const Vector2f corners[4] = { { center.x, center.y - radius }, { center.x + radius, center.y },
+		{ center.x, center.y + radius }, { center.x - radius, center.y } };
+	for (int i = 0; i < 4; ++i) {
+		m_lodVertices.append({ center, color });
+		m_lodVertices.append({ corners[i], edge });
+		m_lodVertices.append({ corners[(i + 1) % 4], edge });
 	}
 }
 
@@ -169,6 +443,17 @@ void Scene_Galaxy::onEnd() {
 }
 
 void Scene_Galaxy::update() {
-	sCamera();
-	sRender();
+	if (m_paused)
+		return;
+
+	m_systems.run(m_registry, m_game->jobs());
+	m_currentFrame++;
+	markDirty();
+}
+
+// Moving entities are interpolated between ticks, and the camera pans every
+// frame while a direction key is held.
+bool Scene_Galaxy::isAnimating() const {
+	const auto& input = m_registry.get<Input>(m_camera);
+	return (!m_paused && !m_registry.view<Movement>().empty()) || input.left || input.right || input.up || input.down;
 }
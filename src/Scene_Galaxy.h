@@ -4,29 +4,81 @@
 
 #include "Scene.h"
 #include "GameEngine.h"
+#include "Broadphase.h"
+#include "ContinuousCollision.h"
+#include "Narrowphase.h"
+#include "LodHierarchy.h"
+#include "Motion.h"
+#include "RenderQueue.h"
+#include "SpatialGrid.h"
+#include "WorldQuery.h"
+#include "SpriteBatch.h"
+#include "StaticGeometry.h"
+#include "Starfield.h"
 
 
 class Scene_Galaxy : public Scene {
 protected:
 
 	entt::entity m_camera;
-	std::unique_ptr<sf::Sprite> m_background;
+	// Repeated nebula texture, drawn as one quad covering the view.
+	const sf::Texture* m_backgroundTexture = nullptr;
+	sf::VertexArray m_background{ sf::PrimitiveType::TriangleStrip, 4 };
+	Starfield m_starfield;
 	sf::View m_view;
+	// Spatial index of Renderable bounds, queried with the view to cull.
+	SpatialGrid m_renderIndex;
+	std::vector<entt::entity> m_visible;
+	// Visible renderables in (layer, texture) order, and their per-frame quads.
+	RenderQueue m_renderQueue;
+	SpriteBatch m_spriteBatch;
+	// Quads of renderables without Movement, cached in vertex buffers.
+	StaticGeometry m_staticGeometry;
+	std::vector<int> m_staticLayers; // Layers with static chunks in view this frame.
+	std::vector<int> m_lineLayers;   // Layers with lines queued this frame.
+	// Low-detail representation: clusters when zoomed far out, points in between.
+	LodHierarchy m_lod;
+	std::vector<LodHierarchy::Cluster> m_clusters;
+	sf::VertexArray m_lodVertices{ sf::PrimitiveType::Triangles };
+	// Collider pairs whose bounds overlap, found once per tick.
+	Broadphase m_broadphase;
+	Narrowphase m_narrowphase;
+	ContinuousCollision m_ccd;
+	// Raycasts and region queries against the colliders.
+	WorldQuery m_world;
 
 	// Pointer to title music (retrieved from Assets  assumed to remain valid)
 	sf::Sound* m_music = nullptr;
 
 	void init();
+	void registerSystems();
 	void sRender() override;
 	void sDoAction(const Action& action) override;
 	void onEnd() override;
 	void sCamera();
+	void sBackground(const sf::FloatRect& viewRect);
+	void sRenderClusters(const sf::FloatRect& viewRect, float unitsPerPixel);
+	void addImpostor(const Vector2f& center, float radius, sf::Color color, bool soft);
+	void sMovement();
+	void sBroadphase();
+	void sNarrowphase();
+	void sProjectiles();
+	void sWorldQuery();
+	void sRenderIndex();
+	void onRenderableConstruct(entt::registry& registry, entt::entity entity);
+	void onRenderableDestroy(entt::registry& registry, entt::entity entity);
+	void onPlacementUpdate(entt::registry& registry, entt::entity entity);
+	void onMovementConstruct(entt::registry& registry, entt::entity entity);
+	void onMovementDestroy(entt::registry& registry, entt::entity entity);
 	void SpawnPlanet(const sf::Vector2f& position, const sf::Vector2f& scale);
 
 
 public:
+	// Safe to construct on a worker thread; audio starts in onActivate().
 	Scene_Galaxy(GameEngine* gameEngine);
+	void onActivate() override;
 	void update() override;
+	bool isAnimating() const override;
 };
 
 
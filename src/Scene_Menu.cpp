@@ -15,14 +15,6 @@ Scene_Menu::Scene_Menu(GameEngine* gameEngine)
 }
 
 void Scene_Menu::init() {
-    // Center the view.
-    sf::View view = m_game->window().getView();
-    view.setCenter(sf::Vector2f{
-        static_cast<float>(m_game->window().getSize().x) / 2.0f,
-        static_cast<float>(m_game->window().getSize().y) / 2.0f
-        });
-    m_game->window().setView(view);
-
     // Register input actions using enum values.
     registerAction(static_cast<int>(sf::Keyboard::Scancode::W), ActionName::Up);
     registerAction(static_cast<int>(sf::Keyboard::Scancode::S), ActionName::Down);
@@ -36,17 +28,9 @@ void Scene_Menu::init() {
 
     // Set up the menu title.
     m_title = "Astral Reign";
-    int titleSize = 30;
-    // Construct m_menuText using a valid font. Wrap m_title in sf::String.
-    m_menuText = std::make_unique<sf::Text>(m_game->assets().getFont("tech"), 
-        sf::String(m_title),
-        static_cast<unsigned int>(titleSize));
-    m_menuText->setFillColor(sf::Color::Black);
-    m_menuText->setPosition(sf::Vector2f{
-        static_cast<float>(m_game->window().getSize().x) / 2.0f -
-        static_cast<float>(titleSize * (m_title.length() + 1)) / 2.0f,
-        static_cast<float>(titleSize * 3)
-        });
+    const sf::Font& font = m_game->assets().getFont("tech");
+    m_menuText = m_ui.addText(font, sf::String(m_title), 30);
+    m_ui.setFillColor(m_menuText, sf::Color::Black);
 
     // Define menu options.
     m_menuStrings.push_back("New Game");
@@ -55,22 +39,49 @@ void Scene_Menu::init() {
 
     // Create text objects for each menu item.
     m_menuItems.clear();
-    for (size_t i = 0; i < m_menuStrings.size(); ++i) {
-        sf::Text text(m_game->assets().getFont("tech"), 
-            sf::String(m_menuStrings[i]),
-            26);
-        text.setFillColor(i == m_selectedMenuIndex ? sf::Color::White : sf::Color::Black);
-        text.setPosition(sf::Vector2f{
-            static_cast<float>(m_game->window().getSize().x) / 2.0f -
-            static_cast<float>(26 * (m_menuStrings[i].length() + 1)) / 2.0f,
-            m_menuText->getGlobalBounds().position.y + 10.0f + 30.0f * static_cast<float>(i + 1)
-            });
-        m_menuItems.push_back(text);
+    for (const auto& item : m_menuStrings)
+        m_menuItems.push_back(m_ui.addText(font, sf::String(item), 26));
+
+    m_helpText = m_ui.addText(font, sf::String("W:UP  S:DOWN  D:ENTER  M:MUTE  ESC:BACK/QUIT"), 26);
+    m_ui.setFillColor(m_helpText, sf::Color::Black);
+    m_ui.setBackground(sf::Color(100, 100, 255));
+
+    updateSelection();
+    layout();
+}
+
+void Scene_Menu::layout() {
+    m_layoutSize = m_game->window().getSize();
+    const float width = static_cast<float>(m_layoutSize.x);
+    const float height = static_cast<float>(m_layoutSize.y);
+    // One pixel per unit, whatever the window size.
+    m_view = sf::View(sf::FloatRect({ 0.f, 0.f }, { width, height }));
+    m_ui.setSize(m_layoutSize);
+
+    // Center each string using a rough per-character width of its font size.
+    auto centeredX = [width](size_t length, unsigned int characterSize) {
+        return width / 2.0f - static_cast<float>(characterSize * (length + 1)) / 2.0f;
+    };
+    const unsigned int titleSize = m_ui.text(m_menuText).getCharacterSize();
+    m_ui.setPosition(m_menuText, { centeredX(m_title.length(), titleSize), static_cast<float>(titleSize * 3) });
+
+    const float itemsTop = m_ui.globalBounds(m_menuText).position.y + 10.0f;
+    for (size_t i = 0; i < m_menuItems.size(); ++i) {
+        m_ui.setPosition(m_menuItems[i], { centeredX(m_menuStrings[i].length(), 26),
+            itemsTop + 30.0f * static_cast<float>(i + 1) });
     }
+
+    const sf::Text& help = m_ui.text(m_helpText);
+    m_ui.setPosition(m_helpText, { centeredX(help.getString().getSize(), help.getCharacterSize()), height - 60.0f });
+}
+
+void Scene_Menu::updateSelection() {
+    for (size_t i = 0; i < m_menuItems.size(); ++i)
+        m_ui.setFillColor(m_menuItems[i], i == m_selectedMenuIndex ? sf::Color::White : sf::Color::Black);
 }
 
 void Scene_Menu::update() {
-    sRender();
+    m_currentFrame++;
 }
 
 void Scene_Menu::onEnd() {
@@ -85,16 +96,21 @@ void Scene_Menu::sDoAction(const Action& action) {
                 m_selectedMenuIndex--;
             else
                 m_selectedMenuIndex = m_menuStrings.size() - 1;
+            updateSelection();
             break;
         case ActionName::Down:
             m_selectedMenuIndex = (m_selectedMenuIndex + 1) % m_menuStrings.size();
+            updateSelection();
             break;
         case ActionName::Activate:
             LOG("On action Activate");
             switch (m_selectedMenuIndex) {
             case 0:
                 m_music->stop();
-                m_game->changeScene("Galaxy View", std::make_shared<Scene_Galaxy>(m_game));
+                // Build the galaxy in the background; the menu keeps rendering meanwhile.
+                m_game->changeSceneAsync("Galaxy View", [game = m_game] {
+                    return std::make_shared<Scene_Galaxy>(game);
+                });
                 break;
             case 1:
 
@@ -128,32 +144,15 @@ void Scene_Menu::sDoAction(const Action& action) {
 }
 
 void Scene_Menu::sRender() {
+    if (m_game->window().getSize() != m_layoutSize)
+        layout();
+
+    RenderPacket& packet = m_game->renderPacket();
+
     // Clear window with a background color.
-    m_game->window().clear(sf::Color(100, 100, 255));
-
-    // Draw the title.
-    m_game->window().draw(*m_menuText);
-
-    // Draw each menu item.
-    for (size_t i = 0; i < m_menuStrings.size(); ++i) {
-        m_menuItems[i].setFillColor(i == m_selectedMenuIndex ? sf::Color::White : sf::Color::Black);
-        m_menuItems[i].setPosition(sf::Vector2f{
-            static_cast<float>(m_game->window().getSize().x) / 2.0f -
-            static_cast<float>(26 * (m_menuStrings[i].length() + 1)) / 2.0f,
-            m_menuText->getGlobalBounds().position.y + 10.0f + 30.0f * static_cast<float>(i + 1)
-            });
-        m_game->window().draw(m_menuItems[i]);
-    }
+    packet.clear(sf::Color(100, 100, 255));
+    packet.setView(m_view);
 
-    // Draw help text.
-    sf::Text help(m_game->assets().getFont("tech"), 
-        sf::String("W:UP  S:DOWN  D:ENTER  M:MUTE  ESC:BACK/QUIT"),
-        26);
-    help.setFillColor(sf::Color::Black);
-    help.setPosition(sf::Vector2f{
-        static_cast<float>(m_game->window().getSize().x) / 2.0f -
-        static_cast<float>(26 * (help.getString().getSize() + 1)) / 2.0f,
-        static_cast<float>(m_game->window().getSize().y) - 60.0f
-        });
-    m_game->window().draw(help);
+    // Title, items and help come from the cached UI layer.
+    m_ui.submit(packet);
 }
@@ -6,6 +6,7 @@
 #include <memory>
 #include "SFML/Graphics/Text.hpp"
 #include "Scene.h"
+#include "UiLayer.h"
 
 // Scene_Menu is the main menu scene.
 class Scene_Menu : public Scene {
@@ -13,17 +14,24 @@ protected:
     std::string m_title;
     std::vector<std::string> m_menuStrings;
 
-    // Use a unique_ptr so we can initialize the text once we have a valid font.
-    std::unique_ptr<sf::Text> m_menuText;
-    std::vector<sf::Text> m_menuItems;
+    // Retained menu text; only re-rendered when the selection or window size changes.
+    UiLayer m_ui;
+    UiLayer::ElementId m_menuText = 0;
+    UiLayer::ElementId m_helpText = 0;
+    std::vector<UiLayer::ElementId> m_menuItems;
+    sf::Vector2u m_layoutSize;
 
     size_t m_selectedMenuIndex = 0;
+    sf::View m_view;
 
     // Pointer to title music (retrieved from Assets  assumed to remain valid)
     sf::Sound* m_music = nullptr;
 
     // Initialize menu layout and register input actions.
     void init();
+    // Position the text for the current window size.
+    void layout();
+    void updateSelection();
 
     // Update and rendering functions.
     void update() override;
@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <cmath>
+#include "SpatialGrid.h"
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : m_cellSize(cellSize) {
+}
+
+int32_t SpatialGrid::cellCoord(float value) const {
+    return static_cast<int32_t>(std::floor(value / m_cellSize));
+}
+
+uint64_t SpatialGrid::cellKey(int32_t x, int32_t y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+void SpatialGrid::insert(entt::entity entity, const sf::FloatRect& bounds) {
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= m_entries.size())
+        m_entries.resize(index + 1);
+
+    Entry& entry = m_entries[index];
+    if (entry.entity != entt::null) {
+        if (entry.entity == entity) {
+            update(entity, bounds);
+            return;
+        }
+        // A destroyed entity whose index was recycled without remove().
+        unlink(entry);
+        m_size--;
+    }
+
+    entry.entity = entity;
+    entry.bounds = bounds;
+    link(entry);
+    m_size++;
+}
+
+void SpatialGrid::update(entt::entity entity, const sf::FloatRect& bounds) {
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= m_entries.size() || m_entries[index].entity != entity) {
+        insert(entity, bounds);
+        return;
+    }
+
+    Entry& entry = m_entries[index];
+    const sf::Vector2f center = bounds.getCenter();
+    const uint64_t cell = cellKey(cellCoord(center.x), cellCoord(center.y));
+    entry.bounds = bounds;
+    m_maxHalfExtent.x = std::max(m_maxHalfExtent.x, bounds.size.x / 2.f);
+    m_maxHalfExtent.y = std::max(m_maxHalfExtent.y, bounds.size.y / 2.f);
+    if (cell != entry.cell) {
+        unlink(entry);
+        link(entry);
+    }
+}
+
+void SpatialGrid::remove(entt::entity entity) {
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= m_entries.size() || m_entries[index].entity != entity)
+        return;
+    unlink(m_entries[index]);
+    m_entries[index] = Entry{};
+    m_size--;
+}
+
+bool SpatialGrid::contains(entt::entity entity) const {
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    return index < m_entries.size() && m_entries[index].entity == entity;
+}
+
+void SpatialGrid::link(Entry& entry) {
+    const sf::Vector2f center = entry.bounds.getCenter();
+    entry.cell = cellKey(cellCoord(center.x), cellCoord(center.y));
+    auto& cell = m_cells[entry.cell];
+    entry.slot = cell.size();
+    cell.push_back(entry.entity);
+    m_maxHalfExtent.x = std::max(m_maxHalfExtent.x, entry.bounds.size.x / 2.f);
+    m_maxHalfExtent.y = std::max(m_maxHalfExtent.y, entry.bounds.size.y / 2.f);
+}
+
+void SpatialGrid::unlink(Entry& entry) {
+    auto it = m_cells.find(entry.cell);
+    if (it == m_cells.end())
+        return;
+
+    // Swap-remove, fixing up the slot of the entity that moved.
+    auto& cell = it->second;
+    const entt::entity moved = cell.back();
+    cell[entry.slot] = moved;
+    m_entries[static_cast<size_t>(entt::to_entity(moved))].slot = entry.slot;
+    cell.pop_back();
+    if (cell.empty())
+        m_cells.erase(it);
+}
+
+void SpatialGrid::query(const sf::FloatRect& area, std::vector<entt::entity>& out) const {
+    // An entity can overlap area while its centre lies up to one half-extent outside it.
+    const int32_t minX = cellCoord(area.position.x - m_maxHalfExtent.x);
+    const int32_t minY = cellCoord(area.position.y - m_maxHalfExtent.y);
+    const int32_t maxX = cellCoord(area.position.x + area.size.x + m_maxHalfExtent.x);
+    const int32_t maxY = cellCoord(area.position.y + area.size.y + m_maxHalfExtent.y);
+
+    auto visit = [&](const std::vector<entt::entity>& cell) {
+        for (entt::entity entity : cell) {
+            if (m_entries[static_cast<size_t>(entt::to_entity(entity))].bounds.findIntersection(area))
+                out.push_back(entity);
+        }
+    };
+
+    // Zoomed far out, walking the stored cells is cheaper than probing empty ones.
+    const uint64_t span = static_cast<uint64_t>(maxX - minX + 1) * static_cast<uint64_t>(maxY - minY + 1);
+    if (span > m_cells.size()) {
+        for (const auto& [key, cell] : m_cells) {
+            const auto x = static_cast<int32_t>(static_cast<uint32_t>(key >> 32));
+            const auto y = static_cast<int32_t>(static_cast<uint32_t>(key));
+            if (x >= minX && x <= maxX && y >= minY && y <= maxY)
+                visit(cell);
+        }
+        return;
+    }
+
+    for (int32_t y = minY; y <= maxY; ++y) {
+        for (int32_t x = minX; x <= maxX; ++x) {
+            auto it = m_cells.find(cellKey(x, y));
+            if (it != m_cells.end())
+                visit(it->second);
+        }
+    }
+}
+
+void SpatialGrid::entities(std::vector<entt::entity>& out) const {
+    out.reserve(out.size() + m_size);
+    for (const Entry& entry : m_entries) {
+        if (entry.entity != entt::null)
+            out.push_back(entry.entity);
+    }
+}
+
+const sf::FloatRect& SpatialGrid::bounds(entt::entity entity) const {
+    return m_entries[static_cast<size_t>(entt::to_entity(entity))].bounds;
+}
+
+float SpatialGrid::cellSize() const {
+    return m_cellSize;
+}
+
+size_t SpatialGrid::size() const {
+    return m_size;
+}
+
+void SpatialGrid::clear() {
+    m_cells.clear();
+    m_entries.clear();
+    m_maxHalfExtent = { 0.f, 0.f };
+    m_size = 0;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <entt/entt.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+// SpatialGrid is a loose uniform grid over world space. Each entity lives in
+// the single cell containing the centre of its bounds, and queries widen the
+// searched area by the largest half-extent inserted so far. Moving an entity
+// only touches the grid when its centre crosses into another cell, and empty
+// cells are never stored (cells are hashed), so the world is unbounded.
+class SpatialGrid {
+public:
+    explicit SpatialGrid(float cellSize = 256.f);
+
+    // Add an entity, or move it if it is already present.
+    void insert(entt::entity entity, const sf::FloatRect& bounds);
+    void update(entt::entity entity, const sf::FloatRect& bounds);
+    void remove(entt::entity entity);
+    [[nodiscard]] bool contains(entt::entity entity) const;
+
+    // Append every entity whose bounds intersect area to out (no duplicates).
+    void query(const sf::FloatRect& area, std::vector<entt::entity>& out) const;
+
+    // Append every stored entity to out, in entity index order.
+    void entities(std::vector<entt::entity>& out) const;
+
+    [[nodiscard]] const sf::FloatRect& bounds(entt::entity entity) const;
+    [[nodiscard]] float cellSize() const;
+    [[nodiscard]] size_t size() const;
+    void clear();
+
+private:
+    struct Entry {
+        entt::entity entity = entt::null;
+        sf::FloatRect bounds;
+        uint64_t cell = 0;
+        size_t slot = 0; // Position inside the cell's entity list.
+    };
+
+    [[nodiscard]] int32_t cellCoord(float value) const;
+    [[nodiscard]] static uint64_t cellKey(int32_t x, int32_t y);
+    void unlink(Entry& entry);
+    void link(Entry& entry);
+
+    float m_cellSize;
+    sf::Vector2f m_maxHalfExtent{ 0.f, 0.f };
+    std::unordered_map<uint64_t, std::vector<entt::entity>> m_cells;
+    std::vector<Entry> m_entries; // Indexed by entity index.
+    size_t m_size = 0;
+};
+
+#endif // SPATIAL_GRID_H
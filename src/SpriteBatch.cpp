@@ -0,0 +1,79 @@
+#include <cmath>
+#include "SpriteBatch.h"
+
+void SpriteBatch::clear() {
+    m_vertices.clear();
+    m_batches.clear();
+    m_quadCount = 0;
+}
+
+void SpriteBatch::add(const sf::Texture& texture, const sf::IntRect& rect, const Vector2f& position,
+    const Vector2f& origin, float rotation, const Vector2f& scale, sf::Color color) {
+    if (m_batches.empty() || m_batches.back().texture != &texture)
+        m_batches.push_back({ &texture, m_vertices.getVertexCount(), 0 });
+    m_batches.back().count += 6;
+
+    sf::Vertex quad[6];
+    buildQuad(quad, rect, position, origin, rotation, scale, color);
+    for (const sf::Vertex& vertex : quad)
+        m_vertices.append(vertex);
+    m_quadCount++;
+}
+
+void SpriteBatch::buildQuad(sf::Vertex* out, const sf::IntRect& rect, const Vector2f& position,
+    const Vector2f& origin, float rotation, const Vector2f& scale, sf::Color color) {
+    const float radians = rotation * 3.14159265f / 180.f;
+    const float cosine = std::cos(radians);
+    const float sine = std::sin(radians);
+    const Vector2f size(static_cast<float>(rect.size.x), static_cast<float>(rect.size.y));
+
+    // Local corner -> world: scale about the origin, rotate, then translate.
+    auto corner = [&](float x, float y) {
+        const float sx = (x - origin.x) * scale.x;
+        const float sy = (y - origin.y) * scale.y;
+        return Vector2f(position.x + sx * cosine - sy * sine, position.y + sx * sine + sy * cosine);
+    };
+    const Vector2f p0 = corner(0.f, 0.f);
+    const Vector2f p1 = corner(size.x, 0.f);
+    const Vector2f p2 = corner(size.x, size.y);
+    const Vector2f p3 = corner(0.f, size.y);
+
+    const float left = static_cast<float>(rect.position.x);
+    const float top = static_cast<float>(rect.position.y);
+    const Vector2f t0(left, top);
+    const Vector2f t1(left + size.x, top);
+    const Vector2f t2(left + size.x, top + size.y);
+    const Vector2f t3(left, top + size.y);
+
+    out[0] = { p0, color, t0 };
+    out[1] = { p1, color, t1 };
+    out[2] = { p2, color, t2 };
+    out[3] = { p0, color, t0 };
+    out[4] = { p2, color, t2 };
+    out[5] = { p3, color, t3 };
+}
+
+void SpriteBatch::add(const TextureRegion& region, const Vector2f& position, float rotation, const Vector2f& scale,
+    sf::Color color) {
+    add(*region.texture, region.rect, position, Vector2f(region.rect.size) / 2.f, rotation, scale, color);
+}
+
+size_t SpriteBatch::quadCount() const {
+    return m_quadCount;
+}
+
+size_t SpriteBatch::drawCalls() const {
+    return m_batches.size();
+}
+
+void SpriteBatch::submit(RenderPacket& packet) const {
+    for (const Batch& batch : m_batches)
+        packet.draw(&m_vertices[batch.first], batch.count, sf::PrimitiveType::Triangles, sf::RenderStates(batch.texture));
+}
+
+void SpriteBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    for (const Batch& batch : m_batches) {
+        states.texture = batch.texture;
+        target.draw(&m_vertices[batch.first], batch.count, sf::PrimitiveType::Triangles, states);
+    }
+}
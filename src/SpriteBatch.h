@@ -0,0 +1,60 @@
+#pragma once
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <vector>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include "RenderPacket.h"
+#include "TextureRegion.h"
+
+using sf::Vector2f;
+
+// SpriteBatch collects textured quads for a frame into one vertex array and
+// draws them in submission order. Consecutive quads that share a texture are
+// merged into one draw call, so feeding it quads sorted by (layer, texture)
+// (see RenderQueue) costs one draw per texture per layer instead of one per
+// sprite. Vertex storage is kept between frames; clear() only resets counts.
+class SpriteBatch : public sf::Drawable {
+public:
+    // Drop all queued quads (keeps allocated memory).
+    void clear();
+
+    // Queue the rect of texture, placed the way sf::Sprite is: origin is in
+    // texture pixels, rotation in degrees, applied as scale, rotate, translate.
+    void add(const sf::Texture& texture, const sf::IntRect& rect, const Vector2f& position,
+        const Vector2f& origin, float rotation, const Vector2f& scale, sf::Color color = sf::Color::White);
+
+    // Queue a region centred on position.
+    void add(const TextureRegion& region, const Vector2f& position, float rotation, const Vector2f& scale,
+        sf::Color color = sf::Color::White);
+
+    // Write the six vertices (two triangles) of a quad placed as in add().
+    static void buildQuad(sf::Vertex* out, const sf::IntRect& rect, const Vector2f& position,
+        const Vector2f& origin, float rotation, const Vector2f& scale, sf::Color color);
+
+    // Record one draw per batch into packet.
+    void submit(RenderPacket& packet) const;
+
+    [[nodiscard]] size_t quadCount() const;
+    [[nodiscard]] size_t drawCalls() const;
+
+private:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    // A run of consecutive quads using the same texture.
+    struct Batch {
+        const sf::Texture* texture = nullptr;
+        size_t first = 0;
+        size_t count = 0;
+    };
+
+    sf::VertexArray m_vertices{ sf::PrimitiveType::Triangles };
+    std::vector<Batch> m_batches;
+    size_t m_quadCount = 0;
+};
+
+#endif // SPRITE_BATCH_H
@@ -0,0 +1,105 @@
+#include <cmath>
+#include "Starfield.h"
+
+// Upper bound on cells generated per layer per frame.
+static constexpr float maxCellsPerLayer = 256.f;
+
+namespace {
+    // splitmix64: a cheap, well-distributed 64-bit mix used both to hash a
+    // cell's coordinates and to step through that cell's star sequence.
+    uint64_t mix(uint64_t x) {
+        x += 0x9e3779b97f4a7c15ull;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+
+    // Uniform float in [0, 1) from the next value of state.
+    float next(uint64_t& state) {
+        state = mix(state);
+        return static_cast<float>(state >> 40) / static_cast<float>(1ull << 24);
+    }
+}
+
+Starfield::Starfield(uint64_t seed)
+    : m_seed(seed) {
+}
+
+void Starfield::addLayer(const StarLayer& layer) {
+    m_layers.push_back(layer);
+}
+
+void Starfield::clearLayers() {
+    m_layers.clear();
+    m_vertices.clear();
+}
+
+size_t Starfield::starCount() const {
+    return m_vertices.getVertexCount() / 6;
+}
+
+void Starfield::update(const sf::FloatRect& viewRect) {
+    m_vertices.clear();
+    const Vector2f viewCenter = viewRect.position + viewRect.size / 2.f;
+
+    for (size_t index = 0; index < m_layers.size(); ++index) {
+        const StarLayer& layer = m_layers[index];
+
+        // The layer lags the camera by (1 - parallax); work in layer space and
+        // shift the stars back into world space when emitting them.
+        const Vector2f shift = viewCenter * (1.f - layer.parallax);
+        const Vector2f min = viewRect.position - shift;
+
+        // Coarser levels when zoomed out keep the cell count bounded.
+        uint64_t level = 0;
+        float cellSize = layer.cellSize;
+        while ((viewRect.size.x / cellSize + 1.f) * (viewRect.size.y / cellSize + 1.f) > maxCellsPerLayer) {
+            cellSize *= 2.f;
+            ++level;
+        }
+        const float sizeScale = cellSize / layer.cellSize;
+
+        const int64_t firstX = static_cast<int64_t>(std::floor(min.x / cellSize));
+        const int64_t firstY = static_cast<int64_t>(std::floor(min.y / cellSize));
+        const int64_t lastX = static_cast<int64_t>(std::floor((min.x + viewRect.size.x) / cellSize));
+        const int64_t lastY = static_cast<int64_t>(std::floor((min.y + viewRect.size.y) / cellSize));
+
+        const uint64_t layerHash = mix(mix(m_seed ^ index) ^ level);
+        for (int64_t y = firstY; y <= lastY; ++y) {
+            for (int64_t x = firstX; x <= lastX; ++x) {
+                uint64_t state = mix(layerHash ^ mix(static_cast<uint64_t>(x)) ^ (static_cast<uint64_t>(y) << 1));
+                const Vector2f cell(static_cast<float>(x) * cellSize, static_cast<float>(y) * cellSize);
+                for (unsigned int star = 0; star < layer.starsPerCell; ++star) {
+                    const Vector2f offset(next(state) * cellSize, next(state) * cellSize);
+                    const float size = (layer.minSize + (layer.maxSize - layer.minSize) * next(state)) * sizeScale;
+                    sf::Color color = layer.color;
+                    color.a = static_cast<uint8_t>(static_cast<float>(color.a) * (0.4f + 0.6f * next(state)));
+                    addStar(cell + offset + shift, size, color);
+                }
+            }
+        }
+    }
+}
+
+void Starfield::addStar(const Vector2f& center, float size, sf::Color color) {
+    const float half = size / 2.f;
+    const Vector2f p0(center.x - half, center.y - half);
+    const Vector2f p1(center.x + half, center.y - half);
+    const Vector2f p2(center.x + half, center.y + half);
+    const Vector2f p3(center.x - half, center.y + half);
+    m_vertices.append({ p0, color });
+    m_vertices.append({ p1, color });
+    m_vertices.append({ p2, color });
+    m_vertices.append({ p0, color });
+    m_vertices.append({ p2, color });
+    m_vertices.append({ p3, color });
+}
+
+void Starfield::submit(RenderPacket& packet) const {
+    packet.draw(m_vertices);
+}
+
+void Starfield::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    states.texture = nullptr;
+    target.draw(m_vertices, states);
+}
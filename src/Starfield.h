@@ -0,0 +1,57 @@
+#pragma once
+#ifndef STARFIELD_H
+#define STARFIELD_H
+
+#include <cstdint>
+#include <vector>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include "RenderPacket.h"
+
+using sf::Vector2f;
+
+// One parallax layer of stars. parallax is how far the layer moves relative to
+// the world: 0 stays fixed to the screen, 1 moves with the world.
+struct StarLayer {
+    float parallax = 0.5f;
+    float cellSize = 256.f;       // World units per cell at normal zoom.
+    unsigned int starsPerCell = 4;
+    float minSize = 1.f;          // Star size range in world units at normal zoom.
+    float maxSize = 2.f;
+    sf::Color color = sf::Color::White;
+};
+
+// Starfield draws an unbounded backdrop of parallax star layers. Stars are not
+// stored: each layer is divided into square cells and a cell's stars are
+// regenerated every frame from a hash of (seed, layer, cell), so the same cell
+// always holds the same stars. When the view is zoomed out, cells double in
+// size (and stars with them) to keep the number of cells per layer bounded,
+// so the cost per frame is constant at any zoom or position.
+class Starfield : public sf::Drawable {
+public:
+    explicit Starfield(uint64_t seed = 0x5eed);
+
+    void addLayer(const StarLayer& layer);
+    void clearLayers();
+
+    // Rebuild the star quads for the world-space view rect.
+    void update(const sf::FloatRect& viewRect);
+
+    void submit(RenderPacket& packet) const;
+
+    [[nodiscard]] size_t starCount() const;
+
+private:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    void addStar(const Vector2f& center, float size, sf::Color color);
+
+    uint64_t m_seed;
+    std::vector<StarLayer> m_layers;
+    sf::VertexArray m_vertices{ sf::PrimitiveType::Triangles };
+};
+
+#endif // STARFIELD_H
@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "StaticGeometry.h"
+#include "SpriteBatch.h"
+
+StaticGeometry::StaticGeometry(float chunkSize)
+    : m_chunkSize(chunkSize) {
+}
+
+void StaticGeometry::add(entt::entity entity, int layer, const sf::Texture& texture, const sf::IntRect& rect,
+    const Vector2f& position, const Vector2f& origin, float rotation, const Vector2f& scale, sf::Color color) {
+    remove(entity);
+
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= m_entries.size())
+        m_entries.resize(index + 1);
+    // A destroyed entity whose index was recycled without remove().
+    if (m_entries[index].entity != entt::null)
+        remove(m_entries[index].entity);
+
+    const ChunkKey key{ layer, &texture, static_cast<int32_t>(std::floor(position.x / m_chunkSize)),
+        static_cast<int32_t>(std::floor(position.y / m_chunkSize)) };
+    Chunk& chunk = m_chunks[key];
+    if (!chunk.buffer)
+        chunk.buffer = std::make_shared<sf::VertexBuffer>(sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Static);
+
+    Entry& entry = m_entries[index];
+    entry = Entry{ entity, &chunk, key, chunk.owners.size() };
+    chunk.owners.push_back(entity);
+    chunk.vertices.resize(chunk.vertices.size() + 6);
+    SpriteBatch::buildQuad(&chunk.vertices[chunk.vertices.size() - 6], rect, position, origin, rotation, scale, color);
+    chunk.dirty = true;
+    chunk.measured = false;
+    m_size++;
+}
+
+void StaticGeometry::add(entt::entity entity, int layer, const TextureRegion& region, const Vector2f& position,
+    float rotation, const Vector2f& scale, sf::Color color) {
+    add(entity, layer, *region.texture, region.rect, position, Vector2f(region.rect.size) / 2.f, rotation, scale, color);
+}
+
+void StaticGeometry::remove(entt::entity entity) {
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= m_entries.size() || m_entries[index].entity != entity)
+        return;
+
+    // Swap-remove the quad, fixing up the entry of the quad that moved.
+    Entry& entry = m_entries[index];
+    Chunk& chunk = *entry.chunk;
+    const size_t last = chunk.owners.size() - 1;
+    if (entry.quad != last) {
+        std::copy_n(chunk.vertices.begin() + static_cast<std::ptrdiff_t>(last * 6), 6,
+            chunk.vertices.begin() + static_cast<std::ptrdiff_t>(entry.quad * 6));
+        chunk.owners[entry.quad] = chunk.owners[last];
+        m_entries[static_cast<size_t>(entt::to_entity(chunk.owners[last]))].quad = entry.quad;
+    }
+    chunk.owners.pop_back();
+    chunk.vertices.resize(last * 6);
+    chunk.dirty = true;
+    chunk.measured = false;
+    if (chunk.owners.empty())
+        m_chunks.erase(entry.key);
+
+    entry = Entry{};
+    m_size--;
+}
+
+bool StaticGeometry::contains(entt::entity entity) const {
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    return index < m_entries.size() && m_entries[index].entity == entity;
+}
+
+bool StaticGeometry::drawn(entt::entity entity) const {
+    const auto index = static_cast<size_t>(entt::to_entity(entity));
+    return index < m_entries.size() && m_entries[index].entity == entity && m_entries[index].chunk->drawn;
+}
+
+void StaticGeometry::measure(Chunk& chunk) {
+    Vector2f min = chunk.vertices.front().position;
+    Vector2f max = min;
+    chunk.minExtent = std::numeric_limits<float>::max();
+    for (size_t quad = 0; quad < chunk.owners.size(); ++quad) {
+        Vector2f quadMin = chunk.vertices[quad * 6].position;
+        Vector2f quadMax = quadMin;
+        for (size_t i = quad * 6; i < quad * 6 + 6; ++i) {
+            const Vector2f& p = chunk.vertices[i].position;
+            quadMin = { std::min(quadMin.x, p.x), std::min(quadMin.y, p.y) };
+            quadMax = { std::max(quadMax.x, p.x), std::max(quadMax.y, p.y) };
+        }
+        min = { std::min(min.x, quadMin.x), std::min(min.y, quadMin.y) };
+        max = { std::max(max.x, quadMax.x), std::max(max.y, quadMax.y) };
+        chunk.minExtent = std::min(chunk.minExtent, std::max(quadMax.x - quadMin.x, quadMax.y - quadMin.y));
+    }
+    chunk.bounds = sf::FloatRect(min, max - min);
+    chunk.measured = true;
+}
+
+void StaticGeometry::cull(const sf::FloatRect& viewRect, float minExtent) {
+    for (auto& [key, chunk] : m_chunks) {
+        if (!chunk.measured)
+            measure(chunk);
+        chunk.drawn = chunk.minExtent >= minExtent && chunk.bounds.findIntersection(viewRect).has_value();
+    }
+}
+
+void StaticGeometry::visibleLayers(std::vector<int>& out) const {
+    for (const auto& [key, chunk] : m_chunks) {
+        const int layer = std::get<0>(key);
+        if (chunk.drawn && (out.empty() || out.back() != layer))
+            out.push_back(layer);
+    }
+}
+
+void StaticGeometry::submit(RenderPacket& packet, int layer) {
+    if (!m_buffersAvailable)
+        m_buffersAvailable = sf::VertexBuffer::isAvailable();
+
+    // The map is ordered by layer first, so the layer's chunks are contiguous.
+    const ChunkKey first{ layer, nullptr, std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::min() };
+    for (auto it = m_chunks.lower_bound(first); it != m_chunks.end() && std::get<0>(it->first) == layer; ++it) {
+        auto& [key, chunk] = *it;
+        if (!chunk.drawn)
+            continue;
+
+        const sf::RenderStates states(std::get<const sf::Texture*>(key));
+        if (!*m_buffersAvailable) {
+            packet.draw(chunk.vertices.data(), chunk.vertices.size(), sf::PrimitiveType::Triangles, states);
+            continue;
+        }
+        if (chunk.dirty) {
+            packet.upload(chunk.buffer, chunk.vertices.data(), chunk.vertices.size());
+            chunk.dirty = false;
+        }
+        packet.draw(chunk.buffer, chunk.vertices.size(), states);
+    }
+}
+
+size_t StaticGeometry::chunkCount() const {
+    return m_chunks.size();
+}
+
+size_t StaticGeometry::size() const {
+    return m_size;
+}
+
+void StaticGeometry::clear() {
+    m_chunks.clear();
+    m_entries.clear();
+    m_size = 0;
+}
@@ -0,0 +1,90 @@
+#pragma once
+#ifndef STATIC_GEOMETRY_H
+#define STATIC_GEOMETRY_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <vector>
+#include <entt/entt.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include "RenderPacket.h"
+#include "TextureRegion.h"
+
+using sf::Vector2f;
+
+// StaticGeometry caches the quads of entities that do not move in persistent
+// sf::VertexBuffers (Static usage). Quads are grouped into chunks by
+// (layer, texture, world cell); a chunk is re-uploaded only after a quad in
+// it is added or removed, so an unchanged static layer costs one draw call
+// per visible chunk and no vertex work at all.
+//
+// Uploads go through the RenderPacket and happen during replay, so buffers
+// are only touched by the thread that owns the window. When vertex buffers
+// are not supported the chunk's vertices are copied into the packet instead.
+class StaticGeometry {
+public:
+    explicit StaticGeometry(float chunkSize = 2048.f);
+
+    // Add (or replace) the quad of an entity, placed as in SpriteBatch::add.
+    void add(entt::entity entity, int layer, const sf::Texture& texture, const sf::IntRect& rect,
+        const Vector2f& position, const Vector2f& origin, float rotation, const Vector2f& scale,
+        sf::Color color = sf::Color::White);
+    // Add the region centred on position.
+    void add(entt::entity entity, int layer, const TextureRegion& region, const Vector2f& position,
+        float rotation, const Vector2f& scale, sf::Color color = sf::Color::White);
+    void remove(entt::entity entity);
+    [[nodiscard]] bool contains(entt::entity entity) const;
+
+    // Pick the chunks to draw this frame: those that intersect viewRect and
+    // whose smallest quad is at least minExtent wide.
+    void cull(const sf::FloatRect& viewRect, float minExtent);
+    // Ascending layers with at least one chunk picked by the last cull().
+    void visibleLayers(std::vector<int>& out) const;
+    // Draw the picked chunks of one layer; dirty chunks are uploaded first.
+    // Submitting layer by layer lets dynamic sprites be drawn between them.
+    void submit(RenderPacket& packet, int layer);
+
+    // Whether the entity's quad was picked by the last cull().
+    [[nodiscard]] bool drawn(entt::entity entity) const;
+
+    [[nodiscard]] size_t chunkCount() const;
+    [[nodiscard]] size_t size() const;
+    void clear();
+
+private:
+    // Layer first so iterating the map draws lower layers first.
+    using ChunkKey = std::tuple<int, const sf::Texture*, int32_t, int32_t>;
+
+    struct Chunk {
+        std::vector<sf::Vertex> vertices; // Six per quad.
+        std::vector<entt::entity> owners; // One per quad.
+        std::shared_ptr<sf::VertexBuffer> buffer;
+        sf::FloatRect bounds;             // Of all quads; valid when measured.
+        float minExtent = 0.f;            // Smallest quad's larger side; valid when measured.
+        bool measured = false;
+        bool dirty = true;                // The buffer does not match the vertices.
+        bool drawn = false;
+    };
+
+    struct Entry {
+        entt::entity entity = entt::null;
+        Chunk* chunk = nullptr;
+        ChunkKey key;
+        size_t quad = 0;
+    };
+
+    static void measure(Chunk& chunk);
+
+    float m_chunkSize;
+    std::map<ChunkKey, Chunk> m_chunks;
+    std::vector<Entry> m_entries; // Indexed by entity index.
+    size_t m_size = 0;
+    std::optional<bool> m_buffersAvailable;
+};
+
+#endif // STATIC_GEOMETRY_H
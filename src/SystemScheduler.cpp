@@ -0,0 +1,95 @@
+#include <algorithm>
+#include "SystemScheduler.h"
+#include "Profiler.h"
+
+const char* SystemScheduler::internName(const std::string& name) {
+    return Profiler::getInstance().intern(name);
+}
+
+void SystemScheduler::addExclusive(const std::string& name, SystemFn fn) {
+    System system;
+    system.name = name;
+    system.prepare = [](entt::registry&) {};
+    system.profileName = internName(name);
+    system.fn = std::move(fn);
+    system.exclusive = true;
+    m_systems.push_back(std::move(system));
+}
+
+void SystemScheduler::setEnabled(const std::string& name, bool enabled) {
+    for (auto& system : m_systems) {
+        if (system.name == name)
+            system.enabled = enabled;
+    }
+}
+
+void SystemScheduler::clear() {
+    m_systems.clear();
+}
+
+size_t SystemScheduler::size() const {
+    return m_systems.size();
+}
+
+bool SystemScheduler::conflicts(const System& a, const System& b) {
+    if (a.exclusive || b.exclusive)
+        return true;
+
+    auto contains = [](const std::vector<entt::id_type>& set, entt::id_type id) {
+        return std::find(set.begin(), set.end(), id) != set.end();
+    };
+    for (auto id : a.writes) {
+        if (contains(b.writes, id) || contains(b.reads, id))
+            return true;
+    }
+    for (auto id : a.reads) {
+        if (contains(b.writes, id))
+            return true;
+    }
+    return false;
+}
+
+void SystemScheduler::buildGraph() {
+    m_active.clear();
+    for (size_t i = 0; i < m_systems.size(); ++i) {
+        if (m_systems[i].enabled)
+            m_active.push_back(i);
+    }
+
+    // Each system depends on every earlier conflicting system. Redundant
+    // (transitive) edges are harmless and the system count is small.
+    const size_t count = m_active.size();
+    m_dependents.assign(count, {});
+    for (size_t later = 0; later < count; ++later) {
+        for (size_t earlier = 0; earlier < later; ++earlier) {
+            if (conflicts(m_systems[m_active[earlier]], m_systems[m_active[later]])) {
+                m_dependents[earlier].push_back(later);
+            }
+        }
+    }
+}
+
+void SystemScheduler::run(entt::registry& registry, JobSystem& jobs) {
+    buildGraph();
+    const size_t count = m_active.size();
+    if (count == 0)
+        return;
+
+    for (size_t index : m_active)
+        m_systems[index].prepare(registry);
+
+    // Edges only point forward, so each system's dependencies are already
+    // scheduled when it is reached.
+    std::vector<std::vector<JobHandle>> dependencies(count);
+    std::vector<JobHandle> handles(count);
+    for (size_t k = 0; k < count; ++k) {
+        const System& system = m_systems[m_active[k]];
+        handles[k] = jobs.schedule([&system] {
+            PROFILE_SCOPE(system.profileName);
+            system.fn();
+        }, dependencies[k]);
+        for (size_t dependent : m_dependents[k])
+            dependencies[dependent].push_back(handles[k]);
+    }
+    jobs.waitAll(handles);
+}
@@ -0,0 +1,99 @@
+#pragma once
+#ifndef SYSTEM_SCHEDULER_H
+#define SYSTEM_SCHEDULER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <entt/entt.hpp>
+#include "JobSystem.h"
+
+// Component access declarations used when registering a system, e.g.
+// scheduler.add("Movement", Reads<Movement>{}, Writes<Transform2D>{}, fn);
+template <typename... Components>
+struct Reads {};
+
+template <typename... Components>
+struct Writes {};
+
+// Non-component state shared by systems (a spatial index, a cache, ...),
+// declared like a component, e.g. Writes<Transform2D, Resource<Broadphase>>.
+// Resources only order systems; they never touch the registry.
+template <typename T>
+struct Resource {};
+
+template <typename T>
+inline constexpr bool isResource = false;
+template <typename T>
+inline constexpr bool isResource<Resource<T>> = true;
+
+// SystemScheduler runs a scene's systems each tick. Every system declares the
+// entt components and Resources it reads and writes; two systems conflict when
+// one writes a component or resource the other reads or writes. Conflicting systems run in registration
+// order, everything else runs concurrently as jobs on the engine's JobSystem.
+//
+// Systems must not create or destroy entities or add/remove components unless
+// registered with addExclusive(), which orders them against every other system.
+class SystemScheduler {
+public:
+    using SystemFn = std::function<void()>;
+
+    template <typename... R, typename... W>
+    void add(const std::string& name, Reads<R...>, Writes<W...>, SystemFn fn) {
+        System system;
+        system.name = name;
+        system.reads = { entt::type_hash<R>::value()... };
+        system.writes = { entt::type_hash<W>::value()... };
+        // Pools are created lazily by entt, which is not thread-safe, so make
+        // sure every declared storage exists before systems run in parallel.
+        system.prepare = [](entt::registry& registry) {
+            (prepareStorage<R>(registry), ...);
+            (prepareStorage<W>(registry), ...);
+        };
+        system.profileName = internName(name);
+        system.fn = std::move(fn);
+        m_systems.push_back(std::move(system));
+    }
+
+    // Register a system that may change the registry's structure.
+    void addExclusive(const std::string& name, SystemFn fn);
+
+    // Enable or disable a system by name (disabled systems are skipped).
+    void setEnabled(const std::string& name, bool enabled);
+
+    // Build this tick's dependency graph and run all enabled systems on jobs.
+    void run(entt::registry& registry, JobSystem& jobs);
+
+    void clear();
+    [[nodiscard]] size_t size() const;
+
+private:
+    struct System {
+        std::string name;
+        const char* profileName = nullptr; // Stable copy of name for profiler zones.
+        std::vector<entt::id_type> reads;
+        std::vector<entt::id_type> writes;
+        std::function<void(entt::registry&)> prepare;
+        SystemFn fn;
+        bool exclusive = false;
+        bool enabled = true;
+    };
+
+    template <typename T>
+    static void prepareStorage(entt::registry& registry) {
+        if constexpr (!isResource<T>)
+            static_cast<void>(registry.storage<T>());
+    }
+
+    static const char* internName(const std::string& name);
+    static bool conflicts(const System& a, const System& b);
+    void buildGraph();
+
+    std::vector<System> m_systems;
+
+    // Per-tick DAG over enabled systems (indices into m_systems).
+    std::vector<size_t> m_active;
+    std::vector<std::vector<size_t>> m_dependents;
+};
+
+#endif // SYSTEM_SCHEDULER_H
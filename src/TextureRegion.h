@@ -0,0 +1,21 @@
+#pragma once
+#ifndef TEXTURE_REGION_H
+#define TEXTURE_REGION_H
+
+#include <cstdint>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+// A sub-rectangle of a texture: either a whole standalone texture, or the
+// slot of a small image packed into a shared atlas page by Assets.
+struct TextureRegion {
+    const sf::Texture* texture = nullptr;
+    sf::IntRect rect;
+    sf::Color average = sf::Color::White; // Alpha-weighted mean colour, for low-detail impostors.
+};
+
+// Index of a region in the Assets region table; stable once assets are loaded.
+using RegionId = uint32_t;
+
+#endif // TEXTURE_REGION_H
@@ -0,0 +1,86 @@
+#include "UiLayer.h"
+
+UiLayer::UiLayer()
+    : m_cache(std::make_shared<RenderCache>()) {
+}
+
+UiLayer::ElementId UiLayer::addText(const sf::Font& font, const sf::String& string, unsigned int characterSize) {
+    m_texts.emplace_back(font, string, characterSize);
+    m_dirty = true;
+    return m_texts.size() - 1;
+}
+
+void UiLayer::setString(ElementId id, const sf::String& string) {
+    if (m_texts[id].getString() == string)
+        return;
+    m_texts[id].setString(string);
+    m_dirty = true;
+}
+
+void UiLayer::setCharacterSize(ElementId id, unsigned int characterSize) {
+    if (m_texts[id].getCharacterSize() == characterSize)
+        return;
+    m_texts[id].setCharacterSize(characterSize);
+    m_dirty = true;
+}
+
+void UiLayer::setFillColor(ElementId id, sf::Color color) {
+    if (m_texts[id].getFillColor() == color)
+        return;
+    m_texts[id].setFillColor(color);
+    m_dirty = true;
+}
+
+void UiLayer::setPosition(ElementId id, const Vector2f& position) {
+    if (m_texts[id].getPosition() == position)
+        return;
+    m_texts[id].setPosition(position);
+    m_dirty = true;
+}
+
+const sf::Text& UiLayer::text(ElementId id) const {
+    return m_texts[id];
+}
+
+sf::FloatRect UiLayer::globalBounds(ElementId id) const {
+    std::lock_guard<std::mutex> lock(RenderPacket::fontMutex());
+    return m_texts[id].getGlobalBounds();
+}
+
+void UiLayer::setSize(sf::Vector2u size) {
+    if (m_size == size)
+        return;
+    m_size = size;
+    m_dirty = true;
+}
+
+void UiLayer::setBackground(sf::Color color) {
+    if (m_background == color)
+        return;
+    m_background = color;
+    m_dirty = true;
+}
+
+sf::Vector2u UiLayer::size() const {
+    return m_size;
+}
+
+bool UiLayer::isDirty() const {
+    return m_dirty;
+}
+
+void UiLayer::submit(RenderPacket& packet) {
+    if (m_size.x == 0 || m_size.y == 0)
+        return;
+
+    if (m_dirty) {
+        // The cache's default view maps one unit to one pixel.
+        packet.beginCache(m_cache, m_size, m_background);
+        packet.setView(sf::View(sf::FloatRect({ 0.f, 0.f }, Vector2f(m_size))));
+        for (const sf::Text& text : m_texts)
+            packet.draw(text);
+        packet.endCache();
+        m_dirty = false;
+    }
+    packet.draw(m_cache);
+}
@@ -0,0 +1,54 @@
+#pragma once
+#ifndef UI_LAYER_H
+#define UI_LAYER_H
+
+#include <memory>
+#include <vector>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include "RenderPacket.h"
+
+using sf::Vector2f;
+
+// UiLayer is retained-mode screen-space text. Elements are created once and
+// only change through the setters, which mark the layer dirty when a value
+// actually changes. The layer is rendered into an offscreen texture on the
+// first frame and after each change; every other frame it costs one textured
+// quad, with no text layout and no copies of the text.
+class UiLayer {
+public:
+    using ElementId = size_t;
+
+    UiLayer();
+
+    ElementId addText(const sf::Font& font, const sf::String& string, unsigned int characterSize);
+    void setString(ElementId id, const sf::String& string);
+    void setCharacterSize(ElementId id, unsigned int characterSize);
+    void setFillColor(ElementId id, sf::Color color);
+    void setPosition(ElementId id, const Vector2f& position);
+    [[nodiscard]] const sf::Text& text(ElementId id) const;
+    // Laid-out bounds of an element (loads its glyphs under the font lock).
+    [[nodiscard]] sf::FloatRect globalBounds(ElementId id) const;
+
+    // Pixel size of the layer (normally the window size) and the colour it
+    // is cleared to; transparent layers are blended over what is below.
+    void setSize(sf::Vector2u size);
+    void setBackground(sf::Color color);
+    [[nodiscard]] sf::Vector2u size() const;
+
+    [[nodiscard]] bool isDirty() const;
+
+    // Record the layer at the packet's current view origin, re-rendering the
+    // cached image first if anything changed since the last submit.
+    void submit(RenderPacket& packet);
+
+private:
+    std::vector<sf::Text> m_texts;
+    sf::Vector2u m_size;
+    sf::Color m_background = sf::Color::Transparent;
+    std::shared_ptr<RenderCache> m_cache;
+    bool m_dirty = true;
+};
+
+#endif // UI_LAYER_H
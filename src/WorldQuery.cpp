@@ -0,0 +1,268 @@
+#include <algorithm>
+#include <cmath>
+#include "WorldQuery.h"
+#include "Broadphase.h"
+#include "ContinuousCollision.h"
+
+// Rays per parallelFor chunk.
+static constexpr size_t rayGrain = 32;
+
+static size_t entityIndex(entt::entity entity) {
+    return static_cast<size_t>(entt::to_entity(entity));
+}
+
+static float dot(const Vector2f& a, const Vector2f& b) {
+    return a.x * b.x + a.y * b.y;
+}
+
+// Squared distance from point to the box [min, max] (0 inside).
+static float boxDistanceSq(const Vector2f& point, const Vector2f& min, const Vector2f& max) {
+    const float dx = std::max({ min.x - point.x, 0.f, point.x - max.x });
+    const float dy = std::max({ min.y - point.y, 0.f, point.y - max.y });
+    return dx * dx + dy * dy;
+}
+
+// World-space points of a ComplexCollider: scale, rotate, then translate.
+static void worldPoints(const entt::registry& registry, entt::entity entity, std::vector<Vector2f>& out) {
+    const auto& transform = registry.get<Transform2D>(entity);
+    const auto& complex = registry.get<ComplexCollider>(entity);
+    const auto* orientation = registry.try_get<Orientation>(entity);
+    const float radians = orientation ? orientation->rotation * 3.14159265f / 180.f : 0.f;
+    const Vector2f scale = orientation ? orientation->scale : Vector2f(1.f, 1.f);
+    const float cosine = std::cos(radians);
+    const float sine = std::sin(radians);
+    out.clear();
+    for (const Vector2f& point : complex.points) {
+        const Vector2f scaled(point.x * scale.x, point.y * scale.y);
+        out.emplace_back(transform.position.x + scaled.x * cosine - scaled.y * sine,
+            transform.position.y + scaled.x * sine + scaled.y * cosine);
+    }
+}
+
+// SAT between a convex polygon and an axis-aligned box.
+static bool polygonOverlapsBox(const std::vector<Vector2f>& points, const Vector2f& min, const Vector2f& max) {
+    Vector2f lo = points[0];
+    Vector2f hi = points[0];
+    for (const Vector2f& point : points) {
+        lo = { std::min(lo.x, point.x), std::min(lo.y, point.y) };
+        hi = { std::max(hi.x, point.x), std::max(hi.y, point.y) };
+    }
+    if (lo.x > max.x || hi.x < min.x || lo.y > max.y || hi.y < min.y)
+        return false;
+
+    const Vector2f corners[4] = { min, { max.x, min.y }, max, { min.x, max.y } };
+    for (size_t i = 0; i < points.size(); ++i) {
+        const Vector2f edge = points[(i + 1) % points.size()] - points[i];
+        const Vector2f axis(-edge.y, edge.x);
+        float polygonMin = dot(points[0], axis);
+        float polygonMax = polygonMin;
+        for (const Vector2f& point : points) {
+            polygonMin = std::min(polygonMin, dot(point, axis));
+            polygonMax = std::max(polygonMax, dot(point, axis));
+        }
+        float boxMin = dot(corners[0], axis);
+        float boxMax = boxMin;
+        for (const Vector2f& corner : corners) {
+            boxMin = std::min(boxMin, dot(corner, axis));
+            boxMax = std::max(boxMax, dot(corner, axis));
+        }
+        if (polygonMin > boxMax || boxMin > polygonMax)
+            return false;
+    }
+    return true;
+}
+
+// A convex polygon and a circle overlap if the centre is inside the polygon
+// or within radius of one of its edges.
+static bool polygonOverlapsCircle(const std::vector<Vector2f>& points, const Vector2f& center, float radius) {
+    bool positive = false;
+    bool negative = false;
+    for (size_t i = 0; i < points.size(); ++i) {
+        const Vector2f& p0 = points[i];
+        const Vector2f edge = points[(i + 1) % points.size()] - p0;
+        const Vector2f toCenter = center - p0;
+        const float side = edge.x * toCenter.y - edge.y * toCenter.x;
+        positive |= side > 0.f;
+        negative |= side < 0.f;
+
+        const float lengthSq = dot(edge, edge);
+        const float t = lengthSq > 0.f ? std::clamp(dot(toCenter, edge) / lengthSq, 0.f, 1.f) : 0.f;
+        const Vector2f closest = toCenter - edge * t;
+        if (dot(closest, closest) <= radius * radius)
+            return true;
+    }
+    return !(positive && negative);
+}
+
+WorldQuery::WorldQuery(float margin)
+    : m_tree(margin) {
+}
+
+void WorldQuery::connect(entt::registry& registry) {
+    registry.on_construct<BoxCollider>().connect<&WorldQuery::onColliderChange>(*this);
+    registry.on_construct<CircleCollider>().connect<&WorldQuery::onColliderChange>(*this);
+    registry.on_construct<ComplexCollider>().connect<&WorldQuery::onColliderChange>(*this);
+    registry.on_destroy<BoxCollider>().connect<&WorldQuery::onColliderChange>(*this);
+    registry.on_destroy<CircleCollider>().connect<&WorldQuery::onColliderChange>(*this);
+    registry.on_destroy<ComplexCollider>().connect<&WorldQuery::onColliderChange>(*this);
+    registry.on_update<Transform2D>().connect<&WorldQuery::onPlacementUpdate>(*this);
+    registry.on_update<Orientation>().connect<&WorldQuery::onPlacementUpdate>(*this);
+
+    for (auto entity : registry.view<Transform2D>()) {
+        if (registry.any_of<BoxCollider, CircleCollider, ComplexCollider>(entity))
+            m_tree.insert(entity, Broadphase::colliderBounds(registry, entity));
+    }
+    m_tree.rebuild();
+}
+
+void WorldQuery::disconnect(entt::registry& registry) {
+    registry.on_construct<BoxCollider>().disconnect(this);
+    registry.on_construct<CircleCollider>().disconnect(this);
+    registry.on_construct<ComplexCollider>().disconnect(this);
+    registry.on_destroy<BoxCollider>().disconnect(this);
+    registry.on_destroy<CircleCollider>().disconnect(this);
+    registry.on_destroy<ComplexCollider>().disconnect(this);
+    registry.on_update<Transform2D>().disconnect(this);
+    registry.on_update<Orientation>().disconnect(this);
+    clear();
+}
+
+// Destroy signals run before the component is removed, so every change is
+// applied later by update().
+void WorldQuery::onColliderChange(entt::registry&, entt::entity entity) {
+    m_changed.push_back(entity);
+}
+
+// Colliders with Movement are refreshed by update() anyway.
+void WorldQuery::onPlacementUpdate(entt::registry& registry, entt::entity entity) {
+    if (m_tree.contains(entity) && !registry.all_of<Movement>(entity))
+        m_changed.push_back(entity);
+}
+
+void WorldQuery::update(const entt::registry& registry) {
+    for (auto entity : registry.view<Transform2D, BoxCollider, Movement>())
+        m_tree.update(entity, Broadphase::colliderBounds(registry, entity));
+    // Entities with several colliders were already refreshed above.
+    for (auto entity : registry.view<Transform2D, CircleCollider, Movement>(entt::exclude<BoxCollider>))
+        m_tree.update(entity, Broadphase::colliderBounds(registry, entity));
+    for (auto entity : registry.view<Transform2D, ComplexCollider, Movement>(entt::exclude<BoxCollider, CircleCollider>))
+        m_tree.update(entity, Broadphase::colliderBounds(registry, entity));
+
+    for (entt::entity entity : m_changed) {
+        if (registry.valid(entity) && registry.all_of<Transform2D>(entity) &&
+            registry.any_of<BoxCollider, CircleCollider, ComplexCollider>(entity))
+            m_tree.update(entity, Broadphase::colliderBounds(registry, entity));
+        else
+            m_tree.remove(entity);
+    }
+    m_changed.clear();
+
+    if (m_tree.needsRebuild())
+        m_tree.rebuild();
+    else if (m_tree.needsRefit())
+        m_tree.refit();
+}
+
+WorldQuery::RayHit WorldQuery::raycast(const entt::registry& registry, const Vector2f& from, const Vector2f& to,
+    entt::entity ignore) const {
+    RayHit result;
+    m_tree.raycast(from, to, [&](entt::entity entity, float maxTime) {
+        if (entity == ignore)
+            return maxTime;
+        const Intersect hit = ContinuousCollision::sweepTarget(registry, entity, from, to, 0.f);
+        if (!hit.intersect)
+            return maxTime;
+        if (result.entity == entt::null || hit.time < result.time ||
+            (hit.time == result.time && entityIndex(entity) < entityIndex(result.entity)))
+            result = { entity, hit.time, hit.position };
+        return result.time;
+    });
+    return result;
+}
+
+void WorldQuery::raycast(const entt::registry& registry, const std::vector<Ray>& rays, std::vector<RayHit>& hits,
+    JobSystem& jobs) const {
+    hits.assign(rays.size(), RayHit{});
+    jobs.parallelFor(0, rays.size(), rayGrain, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i)
+            hits[i] = raycast(registry, rays[i].from, rays[i].to, rays[i].ignore);
+    });
+}
+
+void WorldQuery::overlapBox(const entt::registry& registry, const sf::FloatRect& area,
+    std::vector<entt::entity>& out) const {
+    const Vector2f min = area.position;
+    const Vector2f max = area.position + area.size;
+    std::vector<entt::entity> candidates;
+    m_tree.query(area, candidates);
+    std::vector<Vector2f> points;
+    const size_t first = out.size();
+    for (entt::entity entity : candidates) {
+        const auto& transform = registry.get<Transform2D>(entity);
+        bool overlaps = false;
+        if (const auto* box = registry.try_get<BoxCollider>(entity)) {
+            const Vector2f center = transform.position + box->offset;
+            const Vector2f half = box->size / 2.f;
+            overlaps = center.x - half.x <= max.x && center.x + half.x >= min.x &&
+                center.y - half.y <= max.y && center.y + half.y >= min.y;
+        }
+        if (const auto* circle = registry.try_get<CircleCollider>(entity); circle && !overlaps)
+            overlaps = boxDistanceSq(transform.position + circle->offset, min, max) <= circle->radius * circle->radius;
+        if (const auto* complex = registry.try_get<ComplexCollider>(entity); complex && !overlaps && complex->points.size() >= 3) {
+            worldPoints(registry, entity, points);
+            overlaps = polygonOverlapsBox(points, min, max);
+        }
+        if (overlaps)
+            out.push_back(entity);
+    }
+    std::sort(out.begin() + first, out.end(),
+        [](entt::entity lhs, entt::entity rhs) { return entityIndex(lhs) < entityIndex(rhs); });
+}
+
+void WorldQuery::overlapCircle(const entt::registry& registry, const Vector2f& center, float radius,
+    std::vector<entt::entity>& out) const {
+    const Vector2f extent(radius, radius);
+    std::vector<entt::entity> candidates;
+    m_tree.query(sf::FloatRect(center - extent, extent * 2.f), candidates);
+    std::vector<Vector2f> points;
+    const size_t first = out.size();
+    for (entt::entity entity : candidates) {
+        const auto& transform = registry.get<Transform2D>(entity);
+        bool overlaps = false;
+        if (const auto* box = registry.try_get<BoxCollider>(entity)) {
+            const Vector2f boxCenter = transform.position + box->offset;
+            const Vector2f half = box->size / 2.f;
+            overlaps = boxDistanceSq(center, boxCenter - half, boxCenter + half) <= radius * radius;
+        }
+        if (const auto* circle = registry.try_get<CircleCollider>(entity); circle && !overlaps) {
+            const Vector2f delta = transform.position + circle->offset - center;
+            const float reach = radius + circle->radius;
+            overlaps = dot(delta, delta) <= reach * reach;
+        }
+        if (const auto* complex = registry.try_get<ComplexCollider>(entity); complex && !overlaps && complex->points.size() >= 3) {
+            worldPoints(registry, entity, points);
+            overlaps = polygonOverlapsCircle(points, center, radius);
+        }
+        if (overlaps)
+            out.push_back(entity);
+    }
+    std::sort(out.begin() + first, out.end(),
+        [](entt::entity lhs, entt::entity rhs) { return entityIndex(lhs) < entityIndex(rhs); });
+}
+
+void WorldQuery::nearestK(const Vector2f& point, size_t k, std::vector<entt::entity>& out) const {
+    m_tree.nearest(point, k, out);
+}
+
+const AabbTree& WorldQuery::tree() const {
+    return m_tree;
+}
+
+size_t WorldQuery::size() const {
+    return m_tree.size();
+}
+
+void WorldQuery::clear() {
+    m_tree.clear();
+    m_changed.clear();
+}
@@ -0,0 +1,82 @@
+#pragma once
+#ifndef WORLD_QUERY_H
+#define WORLD_QUERY_H
+
+#include <vector>
+#include <entt/entt.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include "AabbTree.h"
+#include "Components.hpp"
+#include "JobSystem.h"
+
+using sf::Vector2f;
+
+// WorldQuery answers spatial questions about the colliders of a scene:
+// raycasts for line of sight and weapon targeting, box and circle overlaps
+// for sensors and mouse picking, and the nearest colliders to a point.
+//
+// Colliders (Box, Circle and ComplexCollider on an entity with a Transform2D)
+// are kept in an AabbTree, so a query only tests the few colliders near it
+// instead of every entity. connect() tracks colliders as they come and go,
+// and static ones whose Transform2D or Orientation is patched or replaced;
+// those changes and the moves of entities with Movement are applied by
+// update(), which then refits the tree or rebuilds it once refits have made
+// it too costly. Shapes are tested exactly, as ContinuousCollision does, with
+// ComplexCollider points scaled and rotated by the entity's Orientation.
+//
+// All queries are const: any thread may run them while the registry and the
+// tree are not being modified, e.g. from a system that reads WorldQuery.
+class WorldQuery {
+public:
+    struct Ray {
+        Vector2f from{ 0.f, 0.f };
+        Vector2f to{ 0.f, 0.f };
+        entt::entity ignore = entt::null; // Usually the entity casting the ray.
+    };
+
+    // entity is null on a miss.
+    struct RayHit {
+        entt::entity entity = entt::null;
+        float time = 0.f;          // Fraction of the way from the ray's start.
+        Vector2f point{ 0.f, 0.f };
+    };
+
+    explicit WorldQuery(float margin = 8.f);
+
+    // Track the colliders of registry from now on (existing ones are added).
+    void connect(entt::registry& registry);
+    void disconnect(entt::registry& registry);
+
+    // Apply collider changes and movement since the last update.
+    void update(const entt::registry& registry);
+
+    // First collider crossed by the segment from -> to; a ray starting inside
+    // a collider hits it at time 0. Equal times go to the lower entity index.
+    [[nodiscard]] RayHit raycast(const entt::registry& registry, const Vector2f& from, const Vector2f& to,
+        entt::entity ignore = entt::null) const;
+    // One hit per ray, cast in parallel batches.
+    void raycast(const entt::registry& registry, const std::vector<Ray>& rays, std::vector<RayHit>& hits,
+        JobSystem& jobs) const;
+
+    // Append the entities whose colliders overlap the area, in entity index
+    // order. Touching counts as overlapping.
+    void overlapBox(const entt::registry& registry, const sf::FloatRect& area, std::vector<entt::entity>& out) const;
+    void overlapCircle(const entt::registry& registry, const Vector2f& center, float radius,
+        std::vector<entt::entity>& out) const;
+
+    // The k entities whose collider bounds are nearest to point, nearest first.
+    void nearestK(const Vector2f& point, size_t k, std::vector<entt::entity>& out) const;
+
+    [[nodiscard]] const AabbTree& tree() const;
+    [[nodiscard]] size_t size() const;
+    void clear();
+
+private:
+    void onColliderChange(entt::registry& registry, entt::entity entity);
+    void onPlacementUpdate(entt::registry& registry, entt::entity entity);
+
+    AabbTree m_tree;
+    std::vector<entt::entity> m_changed; // Colliders added, removed or moved since update().
+};
+
+#endif // WORLD_QUERY_H
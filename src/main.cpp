@@ -1,8 +1,10 @@
+#include <string>
+#include <vector>
 #include "GameEngine.h"
 
 
-int main() {
-    GameEngine gameEngine("config/config.json");
+int main(int argc, char* argv[]) {
+    GameEngine gameEngine("config/config.json", std::vector<std::string>(argv + 1, argv + argc));
     gameEngine.run();
 
     return 0;